@@ -5,4 +5,5 @@
 
 #include <iostream>
 
-// TODO: Reference additional headers your program requires here.
+#include "CompileServer.h"
+#include "Driver.h"
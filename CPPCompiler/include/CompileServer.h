@@ -0,0 +1,42 @@
+#pragma once
+
+#include "FileCache.h"
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace CPPCompiler {
+    namespace Driver {
+
+        struct ServerOptions {
+            std::string socketPath;
+            std::chrono::seconds idleTimeout{ 600 };     // Exit after this long without a request; 0 disables
+            size_t maxCacheBytes = 256 * 1024 * 1024;    // Upper bound for cached replies
+        };
+
+        // Long-lived process that serves lex requests over a Unix domain socket.
+        // Lexer tables are built once per process; each file's serialized reply
+        // is kept in a FileCache between requests.
+        //
+        // Protocol: the client sends an absolute path terminated by '\n'. The server
+        // answers "OK <n>\n" followed by n bytes of lexer diagnostics and then the token
+        // listing, or "ERROR <message>\n", then closes.
+        class CompileServer {
+        public:
+            explicit CompileServer(ServerOptions options);
+
+            // Serves requests one at a time until the idle timeout expires.
+            int run();
+
+        private:
+            ServerOptions options;
+            FileCache cache;
+        };
+
+        // Thin client: forwards one file to the server and prints the reply, with the
+        // lexer diagnostics going to err as they would in standalone mode.
+        int runClient(const std::string& socketPath, const std::string& path, std::ostream& out, std::ostream& err);
+
+    }
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ILexer.h"
+#include <iosfwd>
+#include <string>
+
+namespace CPPCompiler {
+    namespace Driver {
+
+        const char* tokenTypeName(Lexer::TokenType type);
+
+        // Writes one token per line: "<line>:<column>\t<type>\t<lexeme>"
+        void writeToken(std::ostream& out, const Lexer::Token& token);
+        void writeToken(std::ostream& out, const Lexer::TokenView& token);
+
+        bool readFile(const std::string& path, std::string& contents);
+
+        // Standalone mode: lexes the file through the pipelined lexer and prints its tokens.
+        int lexFile(const std::string& path, std::ostream& out, std::ostream& err);
+
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace CPPCompiler {
+    namespace Driver {
+
+        // A source file lexed into the compile server's reply, as of the recorded mtime
+        // and size. Only the serialized form is kept, so a cache hit is a single write.
+        struct LexedFile {
+            std::filesystem::file_time_type modified;
+            uintmax_t fileSize = 0;
+            std::string reply; // "OK <n>\n", n bytes of lexer diagnostics, then the token listing
+            size_t bytes = 0;  // Memory charged against the cache budget
+        };
+
+        // Lexed files keyed by path, validated against mtime and size on every lookup
+        // and evicted least recently used first once maxBytes is exceeded.
+        class FileCache {
+        public:
+            explicit FileCache(size_t maxBytes);
+
+            // Returns the cached entry if it is still current, otherwise reads and lexes
+            // the file. A file larger than maxBytes is returned without being cached.
+            // Returns nullptr and sets error if the file cannot be read.
+            std::shared_ptr<const LexedFile> load(const std::string& path, std::string& error);
+
+            bool contains(const std::string& path) const { return entries.count(path) != 0; }
+            size_t size() const { return entries.size(); }
+            size_t bytes() const { return cacheBytes; }
+
+        private:
+            struct Entry {
+                std::shared_ptr<const LexedFile> file;
+                std::list<std::string>::iterator recentPosition;
+            };
+
+            void erase(const std::string& path);
+            void evictToFit(size_t incomingBytes);
+
+            size_t maxBytes;
+            std::unordered_map<std::string, Entry> entries;
+            std::list<std::string> recentlyUsed; // Most recently used path first
+            size_t cacheBytes = 0;
+        };
+
+    }
+}
@@ -0,0 +1,271 @@
+#include "CompileServer.h"
+#include "Lexer.h"
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <string_view>
+#include <system_error>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace CPPCompiler {
+    namespace Driver {
+
+#ifndef _WIN32
+        namespace {
+
+            constexpr size_t MaxRequestLength = 4096;
+            constexpr int ClientTimeoutSeconds = 5;
+
+            bool makeAddress(const std::string& socketPath, sockaddr_un& address) {
+                address = sockaddr_un{};
+                address.sun_family = AF_UNIX;
+                if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path)) {
+                    return false;
+                }
+                std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+                return true;
+            }
+
+            int connectTo(const std::string& socketPath) {
+                sockaddr_un address;
+                if (!makeAddress(socketPath, address)) {
+                    return -1;
+                }
+                int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+                if (fd < 0) {
+                    return -1;
+                }
+                if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+                    ::close(fd);
+                    return -1;
+                }
+                return fd;
+            }
+
+            bool writeAll(int fd, std::string_view data) {
+                size_t written = 0;
+                while (written < data.size()) {
+                    ssize_t result = ::write(fd, data.data() + written, data.size() - written);
+                    if (result < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        return false;
+                    }
+                    written += static_cast<size_t>(result);
+                }
+                return true;
+            }
+
+            enum class RequestStatus {
+                Complete,
+                TooLong,
+                Failed
+            };
+
+            // Reads until '\n' (not included) or until the peer closes, a chunk at a time.
+            // The client sends nothing after the newline.
+            RequestStatus readRequest(int fd, std::string& line) {
+                char buffer[MaxRequestLength];
+                while (true) {
+                    ssize_t result = ::read(fd, buffer, sizeof(buffer));
+                    if (result < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (result < 0) {
+                        return RequestStatus::Failed; // Includes the receive timeout
+                    }
+                    if (result == 0) {
+                        return line.empty() ? RequestStatus::Failed : RequestStatus::Complete;
+                    }
+                    std::string_view chunk(buffer, static_cast<size_t>(result));
+                    size_t newline = chunk.find('\n');
+                    line.append(chunk.substr(0, newline));
+                    if (line.size() > MaxRequestLength) {
+                        return RequestStatus::TooLong;
+                    }
+                    if (newline != std::string_view::npos) {
+                        return RequestStatus::Complete;
+                    }
+                }
+            }
+
+            void readAll(int fd, std::string& data) {
+                char buffer[64 * 1024];
+                while (true) {
+                    ssize_t result = ::read(fd, buffer, sizeof(buffer));
+                    if (result < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    if (result <= 0) {
+                        return;
+                    }
+                    data.append(buffer, static_cast<size_t>(result));
+                }
+            }
+
+        }
+#endif
+
+        CompileServer::CompileServer(ServerOptions options)
+            : options(std::move(options)), cache(this->options.maxCacheBytes) {
+        }
+
+        int CompileServer::run() {
+#ifdef _WIN32
+            std::cerr << "Server mode requires Unix domain sockets and is not supported on this platform" << std::endl;
+            return 1;
+#else
+            sockaddr_un address;
+            if (!makeAddress(options.socketPath, address)) {
+                std::cerr << "Invalid socket path: " << options.socketPath << std::endl;
+                return 1;
+            }
+
+            // A socket file nobody answers on is left over from a previous server.
+            int existing = connectTo(options.socketPath);
+            if (existing >= 0) {
+                ::close(existing);
+                std::cerr << "A compile server is already listening on " << options.socketPath << std::endl;
+                return 1;
+            }
+            ::unlink(options.socketPath.c_str());
+
+            // The server returns the contents of any file it can read, so only its own
+            // user may connect. Nobody can connect before listen(), so chmod is not racy.
+            int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listener < 0
+                || ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0
+                || ::chmod(options.socketPath.c_str(), S_IRUSR | S_IWUSR) < 0
+                || ::listen(listener, SOMAXCONN) < 0) {
+                std::cerr << "Cannot listen on " << options.socketPath << ": " << std::strerror(errno) << std::endl;
+                if (listener >= 0) {
+                    ::close(listener);
+                }
+                return 1;
+            }
+
+            // A client that disconnects early must not kill the server.
+            std::signal(SIGPIPE, SIG_IGN);
+
+            // Build the lexer tables now so the first request is served warm.
+            Lexer::LexerTables::shared();
+
+            // poll() takes an int; longer timeouts are capped at about 24 days.
+            constexpr std::chrono::seconds maxIdleTimeout{ std::numeric_limits<int>::max() / 1000 };
+            int idleMilliseconds = options.idleTimeout.count() > 0
+                ? static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(std::min(options.idleTimeout, maxIdleTimeout)).count())
+                : -1;
+            while (true) {
+                pollfd pending{ listener, POLLIN, 0 };
+                int ready = ::poll(&pending, 1, idleMilliseconds);
+                if (ready == 0) {
+                    break; // Idle timeout
+                }
+                if (ready < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    std::cerr << "poll failed: " << std::strerror(errno) << std::endl;
+                    break;
+                }
+
+                int client = ::accept(listener, nullptr, nullptr);
+                if (client < 0) {
+                    continue;
+                }
+
+                // Don't let a client that stops sending or reading block every other request.
+                timeval timeout{ ClientTimeoutSeconds, 0 };
+                ::setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+                ::setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+                std::string request;
+                RequestStatus status = readRequest(client, request);
+                if (status == RequestStatus::TooLong) {
+                    writeAll(client, "ERROR path too long\n");
+                }
+                else if (status == RequestStatus::Complete) {
+                    std::string error;
+                    std::shared_ptr<const LexedFile> file = cache.load(request, error);
+                    if (file) {
+                        writeAll(client, file->reply); // Cached replies are sent as stored
+                    }
+                    else {
+                        writeAll(client, "ERROR " + error + "\n");
+                    }
+                }
+                ::close(client);
+            }
+
+            ::close(listener);
+            ::unlink(options.socketPath.c_str());
+            return 0;
+#endif
+        }
+
+        int runClient(const std::string& socketPath, const std::string& path, std::ostream& out, std::ostream& err) {
+#ifdef _WIN32
+            (void)socketPath;
+            (void)path;
+            (void)out;
+            err << "Client mode requires Unix domain sockets and is not supported on this platform" << std::endl;
+            return 1;
+#else
+            // The server has its own working directory.
+            std::error_code ec;
+            std::string absolutePath = std::filesystem::absolute(path, ec).string();
+            if (ec || absolutePath.find('\n') != std::string::npos) {
+                err << "Invalid path: " << path << std::endl;
+                return 1;
+            }
+
+            int fd = connectTo(socketPath);
+            if (fd < 0) {
+                err << "Cannot connect to compile server at " << socketPath << std::endl;
+                return 1;
+            }
+
+            std::string reply;
+            if (writeAll(fd, absolutePath + "\n")) {
+                ::shutdown(fd, SHUT_WR);
+                readAll(fd, reply);
+            }
+            ::close(fd);
+
+            if (reply.rfind("OK ", 0) == 0) {
+                size_t headerEnd = reply.find('\n');
+                size_t diagnosticsLength = 0;
+                auto [ptr, ec] = std::from_chars(reply.data() + 3, reply.data() + std::min(headerEnd, reply.size()), diagnosticsLength);
+                if (headerEnd != std::string::npos && ec == std::errc() && ptr == reply.data() + headerEnd
+                    && diagnosticsLength <= reply.size() - headerEnd - 1) {
+                    std::string_view body = std::string_view(reply).substr(headerEnd + 1);
+                    err << body.substr(0, diagnosticsLength);
+                    out << body.substr(diagnosticsLength);
+                    return 0;
+                }
+            }
+            if (reply.rfind("ERROR ", 0) == 0) {
+                err << std::string_view(reply).substr(6);
+                return 1;
+            }
+            err << "Malformed reply from compile server" << std::endl;
+            return 1;
+#endif
+        }
+
+    }
+}
@@ -0,0 +1,65 @@
+#include "Driver.h"
+#include "PipelinedLexer.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace CPPCompiler {
+    namespace Driver {
+
+        const char* tokenTypeName(Lexer::TokenType type) {
+            using Lexer::TokenType;
+            switch (type) {
+            case TokenType::Identifier: return "Identifier";
+            case TokenType::Keyword: return "Keyword";
+            case TokenType::Literal: return "Literal";
+            case TokenType::Operator: return "Operator";
+            case TokenType::Separator: return "Separator";
+            case TokenType::Comment: return "Comment";
+            case TokenType::PreprocessorDirective: return "PreprocessorDirective";
+            case TokenType::Unknown: return "Unknown";
+            case TokenType::EndOfFile: return "EndOfFile";
+            }
+            return "Unknown";
+        }
+
+        void writeToken(std::ostream& out, const Lexer::Token& token) {
+            out << token.line << ':' << token.column << '\t'
+                << tokenTypeName(token.type) << '\t' << token.lexeme << '\n';
+        }
+
+        void writeToken(std::ostream& out, const Lexer::TokenView& token) {
+            out << token.line << ':' << token.column << '\t'
+                << tokenTypeName(token.type) << '\t' << token.lexeme << '\n';
+        }
+
+        bool readFile(const std::string& path, std::string& contents) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file) {
+                return false;
+            }
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            contents = buffer.str();
+            return true;
+        }
+
+        int lexFile(const std::string& path, std::ostream& out, std::ostream& err) {
+            std::string source;
+            if (!readFile(path, source)) {
+                err << "Cannot open " << path << std::endl;
+                return 1;
+            }
+
+            // Lex on a separate thread and print tokens as batches arrive.
+            Lexer::PipelinedLexer lexer(source, err);
+            lexer.forEachToken([&out](const Lexer::TokenView& token) {
+                if (token.type != Lexer::TokenType::EndOfFile) {
+                    writeToken(out, token);
+                }
+            });
+            return 0;
+        }
+
+    }
+}
@@ -0,0 +1,83 @@
+#include "FileCache.h"
+#include "Driver.h"
+#include "Lexer.h"
+#include <sstream>
+#include <system_error>
+
+namespace CPPCompiler {
+    namespace Driver {
+
+        FileCache::FileCache(size_t maxBytes)
+            : maxBytes(maxBytes) {
+        }
+
+        std::shared_ptr<const LexedFile> FileCache::load(const std::string& path, std::string& error) {
+            std::error_code ec;
+            auto modified = std::filesystem::last_write_time(path, ec);
+            uintmax_t fileSize = ec ? 0 : std::filesystem::file_size(path, ec);
+            if (ec) {
+                erase(path);
+                error = "Cannot open " + path;
+                return nullptr;
+            }
+
+            auto cached = entries.find(path);
+            if (cached != entries.end()) {
+                if (cached->second.file->modified == modified && cached->second.file->fileSize == fileSize) {
+                    recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, cached->second.recentPosition);
+                    return cached->second.file;
+                }
+                erase(path); // Stale
+            }
+
+            std::string contents;
+            if (!readFile(path, contents)) {
+                error = "Cannot open " + path;
+                return nullptr;
+            }
+
+            std::ostringstream diagnostics;
+            std::ostringstream listing;
+            Lexer::Lexer lexer(contents);
+            lexer.setDiagnostics(diagnostics);
+            for (const Lexer::TokenView& token : lexer.tokens()) {
+                writeToken(listing, token);
+            }
+
+            auto file = std::make_shared<LexedFile>();
+            file->modified = modified;
+            file->fileSize = fileSize;
+            std::string diagnosticText = diagnostics.str();
+            file->reply = "OK " + std::to_string(diagnosticText.size()) + "\n" + diagnosticText + listing.str();
+            file->bytes = path.size() + file->reply.size();
+
+            if (file->bytes > maxBytes) {
+                return file; // Served once, not kept
+            }
+
+            evictToFit(file->bytes);
+            cacheBytes += file->bytes;
+            recentlyUsed.push_front(path);
+            entries.emplace(path, Entry{ file, recentlyUsed.begin() });
+            return file;
+        }
+
+        void FileCache::erase(const std::string& path) {
+            auto cached = entries.find(path);
+            if (cached == entries.end()) {
+                return;
+            }
+            cacheBytes -= cached->second.file->bytes;
+            recentlyUsed.erase(cached->second.recentPosition);
+            entries.erase(cached);
+        }
+
+        void FileCache::evictToFit(size_t incomingBytes) {
+            while (!recentlyUsed.empty() && cacheBytes + incomingBytes > maxBytes) {
+                std::string oldest = recentlyUsed.back(); // erase() frees the list node
+                erase(oldest);
+            }
+        }
+
+    }
+}
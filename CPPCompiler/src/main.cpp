@@ -1,11 +1,63 @@
-﻿#include <iostream>
-#include <fstream>
-#include <sstream>
+﻿#include "CPPCompiler.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[]) {
+namespace {
 
-    std::cerr << "Nothing to do here for now." << std::endl;
+    void printUsage(const char* program) {
+        std::cerr << "Usage: " << program << " <source-file>\n"
+            << "       " << program << " --server <socket> [--idle-timeout <seconds>] [--max-cache-mb <megabytes>]\n"
+            << "       " << program << " --client <socket> <source-file>" << std::endl;
+    }
+
+    bool parseNumber(const std::string& text, size_t& value) {
+        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return ec == std::errc() && ptr == text.data() + text.size();
+    }
 
-    return 0;
 }
 
+int main(int argc, char* argv[]) {
+
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    if (args.size() == 1 && args[0].rfind("--", 0) != 0) {
+        return CPPCompiler::Driver::lexFile(args[0], std::cout, std::cerr);
+    }
+
+    if (args.size() == 3 && args[0] == "--client") {
+        return CPPCompiler::Driver::runClient(args[1], args[2], std::cout, std::cerr);
+    }
+
+    if (args.size() >= 2 && args[0] == "--server") {
+        CPPCompiler::Driver::ServerOptions options;
+        options.socketPath = args[1];
+        for (size_t i = 2; i < args.size(); i += 2) {
+            size_t value = 0;
+            if (i + 1 >= args.size() || !parseNumber(args[i + 1], value)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            if (args[i] == "--idle-timeout") {
+                using Seconds = std::chrono::seconds;
+                options.idleTimeout = Seconds(static_cast<Seconds::rep>(std::min<size_t>(value, std::numeric_limits<Seconds::rep>::max())));
+            }
+            else if (args[i] == "--max-cache-mb") {
+                constexpr size_t bytesPerMegabyte = 1024 * 1024;
+                options.maxCacheBytes = value > SIZE_MAX / bytesPerMegabyte ? SIZE_MAX : value * bytesPerMegabyte;
+            }
+            else {
+                printUsage(argv[0]);
+                return 1;
+            }
+        }
+        return CPPCompiler::Driver::CompileServer(options).run();
+    }
+
+    printUsage(argv[0]);
+    return 1;
+}
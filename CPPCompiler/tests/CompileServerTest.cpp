@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "CompileServer.h"
+#include "Driver.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace CPPCompiler {
+	namespace Driver {
+
+#ifndef _WIN32
+        namespace {
+
+            // Retries until the server thread is listening.
+            int runClientWhenReady(const std::string& socketPath, const std::string& path, std::string& out, std::string& err) {
+                int result = 1;
+                for (int attempt = 0; attempt < 100; ++attempt) {
+                    std::ostringstream outStream;
+                    std::ostringstream errStream;
+                    result = runClient(socketPath, path, outStream, errStream);
+                    out = outStream.str();
+                    err = errStream.str();
+                    if (err.rfind("Cannot connect", 0) != 0) {
+                        break;
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                }
+                return result;
+            }
+
+        }
+
+        TEST(CompileServerTest, TestRoundTripMatchesStandalone) {
+            std::filesystem::path directory = std::filesystem::temp_directory_path() / "CompileServerTest";
+            std::filesystem::remove_all(directory);
+            std::filesystem::create_directories(directory);
+            std::string source = (directory / "a.cpp").string();
+            std::ofstream(source, std::ios::binary) << "int main() { return @ 42; }\n";
+
+            ServerOptions options;
+            options.socketPath = (directory / "server.sock").string();
+            options.idleTimeout = std::chrono::seconds(1);
+            int serverResult = -1;
+            std::thread server([&] { serverResult = CompileServer(options).run(); });
+
+            std::ostringstream expectedOut;
+            std::ostringstream expectedErr;
+            ASSERT_EQ(lexFile(source, expectedOut, expectedErr), 0);
+
+            // The second request is a cache hit and must replay the same diagnostics.
+            for (int request = 0; request < 2; ++request) {
+                std::string out;
+                std::string err;
+                EXPECT_EQ(runClientWhenReady(options.socketPath, source, out, err), 0);
+                EXPECT_EQ(out, expectedOut.str());
+                EXPECT_EQ(err, expectedErr.str());
+            }
+
+            // Only the server's user may connect.
+            auto permissions = std::filesystem::status(options.socketPath).permissions();
+            EXPECT_EQ(permissions & std::filesystem::perms::all, std::filesystem::perms::owner_read | std::filesystem::perms::owner_write);
+
+            std::string out;
+            std::string err;
+            EXPECT_EQ(runClientWhenReady(options.socketPath, (directory / "missing.cpp").string(), out, err), 1);
+            EXPECT_TRUE(out.empty());
+            EXPECT_NE(err.find("Cannot open"), std::string::npos);
+
+            // Refused with a reply rather than a dropped connection
+            EXPECT_EQ(runClientWhenReady(options.socketPath, (directory / std::string(5000, 'x')).string(), out, err), 1);
+            EXPECT_EQ(err, "path too long\n");
+
+            server.join(); // Returns once the idle timeout expires
+            EXPECT_EQ(serverResult, 0);
+            EXPECT_FALSE(std::filesystem::exists(options.socketPath));
+            std::filesystem::remove_all(directory);
+        }
+#endif
+	}
+}
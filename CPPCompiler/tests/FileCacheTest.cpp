@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include "FileCache.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace CPPCompiler {
+	namespace Driver {
+
+        namespace {
+
+            class FileCacheTest : public ::testing::Test {
+            protected:
+                void SetUp() override {
+                    directory = std::filesystem::temp_directory_path()
+                        / ("FileCacheTest-" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+                    std::filesystem::remove_all(directory);
+                    std::filesystem::create_directories(directory);
+                }
+
+                void TearDown() override {
+                    std::filesystem::remove_all(directory);
+                }
+
+                std::string write(const std::string& name, const std::string& contents) {
+                    std::string path = (directory / name).string();
+                    std::ofstream(path, std::ios::binary) << contents;
+                    return path;
+                }
+
+                std::filesystem::path directory;
+            };
+
+        }
+
+        TEST_F(FileCacheTest, TestHitReturnsSameEntry) {
+            std::string path = write("a.cpp", "int a = 1;");
+            FileCache cache(1024 * 1024);
+            std::string error;
+
+            auto first = cache.load(path, error);
+            ASSERT_NE(first, nullptr);
+            EXPECT_EQ(first->reply,
+                "OK 0\n"
+                "1:1\tKeyword\tint\n"
+                "1:5\tIdentifier\ta\n"
+                "1:7\tOperator\t=\n"
+                "1:9\tLiteral\t1\n"
+                "1:10\tSeparator\t;\n");
+            EXPECT_EQ(cache.size(), 1);
+            EXPECT_EQ(cache.bytes(), first->bytes);
+
+            EXPECT_EQ(cache.load(path, error), first);
+        }
+
+        TEST_F(FileCacheTest, TestMissingFile) {
+            FileCache cache(1024 * 1024);
+            std::string error;
+
+            EXPECT_EQ(cache.load((directory / "missing.cpp").string(), error), nullptr);
+            EXPECT_NE(error.find("Cannot open"), std::string::npos);
+            EXPECT_EQ(cache.size(), 0);
+        }
+
+        TEST_F(FileCacheTest, TestStaleSizeAndModificationTime) {
+            std::string path = write("a.cpp", "int a;");
+            FileCache cache(1024 * 1024);
+            std::string error;
+
+            auto original = cache.load(path, error);
+            ASSERT_NE(original, nullptr);
+
+            // Different size
+            write("a.cpp", "int abc;");
+            auto resized = cache.load(path, error);
+            ASSERT_NE(resized, nullptr);
+            EXPECT_NE(resized, original);
+            EXPECT_NE(resized->reply.find("\tabc\n"), std::string::npos);
+
+            // Same size, only the modification time moves
+            write("a.cpp", "int xyz;");
+            std::filesystem::last_write_time(path, resized->modified + std::chrono::seconds(5));
+            auto touched = cache.load(path, error);
+            ASSERT_NE(touched, nullptr);
+            EXPECT_NE(touched, resized);
+            EXPECT_NE(touched->reply.find("\txyz\n"), std::string::npos);
+
+            EXPECT_EQ(cache.size(), 1);
+            EXPECT_EQ(cache.bytes(), touched->bytes);
+        }
+
+        TEST_F(FileCacheTest, TestLeastRecentlyUsedEviction) {
+            std::string a = write("a.cpp", "int a;");
+            std::string b = write("b.cpp", "int b;");
+            std::string c = write("c.cpp", "int c;");
+            std::string error;
+
+            size_t entryBytes = FileCache(1024 * 1024).load(a, error)->bytes;
+            FileCache cache(entryBytes * 2 + entryBytes / 2); // Room for two
+
+            cache.load(a, error);
+            cache.load(b, error);
+            cache.load(a, error); // b is now least recently used
+            cache.load(c, error);
+
+            EXPECT_TRUE(cache.contains(a));
+            EXPECT_FALSE(cache.contains(b));
+            EXPECT_TRUE(cache.contains(c));
+            EXPECT_EQ(cache.bytes(), entryBytes * 2);
+        }
+
+        TEST_F(FileCacheTest, TestOversizedFileIsNotCached) {
+            std::string small = write("small.cpp", "int a;");
+            std::string large = write("large.cpp", std::string(4096, 'x'));
+            FileCache cache(1024);
+            std::string error;
+
+            ASSERT_NE(cache.load(small, error), nullptr);
+            auto file = cache.load(large, error);
+            ASSERT_NE(file, nullptr);
+            EXPECT_NE(file->reply.find(std::string(4096, 'x')), std::string::npos);
+
+            // Served, but neither kept nor allowed to evict what fits
+            EXPECT_FALSE(cache.contains(large));
+            EXPECT_TRUE(cache.contains(small));
+            EXPECT_EQ(cache.size(), 1);
+        }
+
+        TEST_F(FileCacheTest, TestDiagnosticsAreCaptured) {
+            std::string path = write("a.cpp", "int a = @;");
+            FileCache cache(1024 * 1024);
+            std::string error;
+
+            auto file = cache.load(path, error);
+            ASSERT_NE(file, nullptr);
+            std::string diagnostics = "Lexer error at Line 1, Column 9: Unrecognized character\n";
+            EXPECT_EQ(file->reply.rfind("OK " + std::to_string(diagnostics.size()) + "\n" + diagnostics, 0), 0);
+            EXPECT_EQ(cache.load(path, error), file);
+        }
+	}
+}
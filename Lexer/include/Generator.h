@@ -0,0 +1,114 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace CPPCompiler {
+    namespace Lexer {
+
+        // Minimal lazy coroutine generator (stand-in for C++23 std::generator).
+        // Models std::ranges::input_range, so it works with range-for and std::views adaptors.
+        // A yielded value is only valid until the iterator is advanced.
+        template <typename T>
+        class Generator {
+        public:
+            struct promise_type {
+                const T* current = nullptr;
+                std::exception_ptr exception;
+
+                Generator get_return_object() noexcept {
+                    return Generator{ std::coroutine_handle<promise_type>::from_promise(*this) };
+                }
+                std::suspend_always initial_suspend() const noexcept { return {}; }
+                std::suspend_always final_suspend() const noexcept { return {}; }
+                std::suspend_always yield_value(const T& value) noexcept {
+                    current = std::addressof(value);
+                    return {};
+                }
+                void return_void() const noexcept {}
+                void unhandled_exception() noexcept { exception = std::current_exception(); }
+
+                // Generators only yield; they never await.
+                template <typename U>
+                std::suspend_never await_transform(U&&) = delete;
+            };
+
+            using Handle = std::coroutine_handle<promise_type>;
+
+            class Iterator {
+            public:
+                using iterator_concept = std::input_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using reference = const T&;
+                using pointer = const T*;
+
+                Iterator() = default;
+                explicit Iterator(Handle coroutine) : coroutine(coroutine) {}
+
+                reference operator*() const { return *coroutine.promise().current; }
+                pointer operator->() const { return coroutine.promise().current; }
+
+                Iterator& operator++() {
+                    coroutine.resume();
+                    rethrowIfFailed(coroutine);
+                    return *this;
+                }
+                void operator++(int) { ++*this; }
+
+                friend bool operator==(const Iterator& it, std::default_sentinel_t) noexcept {
+                    return !it.coroutine || it.coroutine.done();
+                }
+
+            private:
+                Handle coroutine = nullptr;
+            };
+
+            Generator() = default;
+            Generator(Generator&& other) noexcept : coroutine(std::exchange(other.coroutine, nullptr)) {}
+            Generator& operator=(Generator&& other) noexcept {
+                if (this != &other) {
+                    if (coroutine) {
+                        coroutine.destroy();
+                    }
+                    coroutine = std::exchange(other.coroutine, nullptr);
+                }
+                return *this;
+            }
+            Generator(const Generator&) = delete;
+            Generator& operator=(const Generator&) = delete;
+
+            ~Generator() {
+                if (coroutine) {
+                    coroutine.destroy();
+                }
+            }
+
+            // Starts the coroutine; may only be called once.
+            Iterator begin() {
+                if (coroutine) {
+                    coroutine.resume();
+                    rethrowIfFailed(coroutine);
+                }
+                return Iterator{ coroutine };
+            }
+            std::default_sentinel_t end() const noexcept { return {}; }
+
+        private:
+            explicit Generator(Handle coroutine) : coroutine(coroutine) {}
+
+            static void rethrowIfFailed(Handle coroutine) {
+                if (coroutine.done() && coroutine.promise().exception) {
+                    std::rethrow_exception(coroutine.promise().exception);
+                }
+            }
+
+            Handle coroutine = nullptr;
+        };
+
+    }
+}
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -21,14 +22,38 @@ namespace CPPCompiler {
             // ... other token types
         };
 
+        // Token::literalIndex for tokens without a decoded literal value
+        constexpr size_t NoLiteral = static_cast<size_t>(-1);
+
         struct Token {
             TokenType type;
             std::string lexeme;
             size_t line;
             size_t column;
+            size_t literalIndex = NoLiteral; // Entry in the lexer's LiteralTable for Literal tokens
             // Additional data members as needed
         };
 
+        // Non-owning token: the lexeme points into the lexer's source buffer
+        // and stays valid for as long as the lexer that produced it.
+        struct TokenView {
+            TokenType type;
+            std::string_view lexeme;
+            size_t line;
+            size_t column;
+            size_t literalIndex = NoLiteral;
+        };
+
+        // Lexer position captured by ILexer::save(); restore() rewinds to it.
+        // Plain value type: copying it never touches the source or the lexer tables.
+        struct Checkpoint {
+            size_t position;
+            size_t line;
+            size_t column;
+            size_t tokenIndex;   // Tokens returned by getNextToken() before this point
+            size_t literalCount; // Literals scanned before this point
+        };
+
         // Define a type for state identifiers
         using State = int;
 
@@ -43,6 +68,10 @@ namespace CPPCompiler {
         class ILexer {
         public:
             virtual Token getNextToken() = 0;
+            // Token k positions ahead of the next getNextToken() result (k = 0 is that token).
+            virtual const Token& peekToken(size_t k) = 0;
+            virtual Checkpoint save() = 0;
+            virtual void restore(const Checkpoint& checkpoint) = 0;
             virtual Token runAutomaton(const Automaton& automaton) = 0;
             virtual TokenType determineTokenType(const std::string& lexeme, const Automaton& automaton) = 0;
             virtual ~ILexer() = default;
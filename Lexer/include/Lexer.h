@@ -1,8 +1,13 @@
 #pragma once
 
 #include "ILexer.h"
+#include "Generator.h"
+#include "LexerTables.h"
+#include "LiteralTable.h"
+#include <array>
+#include <iosfwd>
 #include <string>
-#include <unordered_set>
+#include <string_view>
 
 namespace CPPCompiler {
     namespace Lexer {
@@ -11,38 +16,91 @@ namespace CPPCompiler {
         public:
             Lexer(const std::string& source);
 
+            // Tokens that peekToken() can see past the next one, and the number of
+            // already-returned tokens kept for restore() without re-lexing.
+            static constexpr size_t LookaheadCapacity = 16;
+
             Token getNextToken() override;
 
+            // Lexes ahead into a small ring buffer; k must be below LookaheadCapacity.
+            const Token& peekToken(size_t k) override;
+
+            // Both O(1). Restoring to a checkpoint whose tokens are still in the ring buffer
+            // only moves the read cursor; any other checkpoint, earlier or later, resets
+            // the scanner itself. Tokens lexed again after that are not re-reported as
+            // errors and keep their literal entries, so literalIndex values stay valid.
+            // save() also makes getNextToken() keep the next LookaheadCapacity tokens in
+            // the ring, so restoring soon afterwards is served from it.
+            // Applies to the getNextToken()/peekToken() stream, not to tokens().
+            Checkpoint save() override;
+            void restore(const Checkpoint& checkpoint) override;
+
 			Token runAutomaton(const Automaton& automaton) override;
 
 			TokenType determineTokenType(const std::string& lexeme, const Automaton& automaton) override;
 
+            // Lazily yields every token up to (not including) EndOfFile from a single
+            // scan loop, without per-token virtual dispatch or lexeme allocation.
+            // Composes with std::views, e.g. lexer.tokens() | std::views::filter(...).
+            Generator<TokenView> tokens();
+
+            // Scans the next token, EndOfFile included, as a view into the source.
+            // Like tokens(), this bypasses the lookahead ring, so don't interleave it
+            // with getNextToken()/peekToken()/restore().
+            TokenView nextTokenView() { return scanToken(); }
+
+            // Decoded values of every literal lexed so far, indexed by Token::literalIndex.
+            const LiteralTable& literals() const { return externalLiterals ? *externalLiterals : literalTable; }
+
+            // Decodes further literals into table instead of the lexer's own, numbering
+            // them from table.size(). Lets a caller recycle the storage (the pipeline keeps
+            // one table per batch). Don't restore() a checkpoint saved before the switch.
+            void setLiteralTable(LiteralTable& table) { externalLiterals = &table; nextLiteral = table.size(); }
+
+            // Where lexical errors are reported; std::cerr unless redirected.
+            void setDiagnostics(std::ostream& out) { diagnostics = &out; }
+
         private:
             // Data Members
             std::string sourceBuffer;
             size_t currentPosition;
             size_t line;
             size_t column;
+            bool asciiOnly; // Set once per source; skips every UTF-8 check when true
+            std::ostream* diagnostics;
+
+            const LexerTables& tables;
+
+            LiteralTable literalTable;
+            LiteralTable* externalLiterals; // Set by setLiteralTable(); replaces literalTable
+
+            struct LookaheadEntry {
+                Token token;
+                Checkpoint before; // Scanner state before this token was lexed
+            };
 
-            std::unordered_set<std::string> keywords;
-            std::unordered_set<std::string> operators;
-			std::unordered_set<std::string> separators;
+            std::array<LookaheadEntry, LookaheadCapacity> lookahead;
+            size_t consumedCount; // Tokens returned by getNextToken()
+            size_t lexedCount;    // Tokens scanned into the ring buffer
+            size_t historyStart;  // Oldest token index whose ring slot is still valid
+            size_t scannedCount;  // Highest lexedCount reached; tokens below it are being re-scanned
+            size_t nextLiteral;   // literalIndex for the next literal scanned
+            bool replaying;       // Re-scanning below scannedCount: errors were already reported
+            size_t lastSaveIndex; // tokenIndex of the latest save(), or NoSave
 
-            Automaton identifierAutomaton;
-            Automaton numberAutomaton;
-            Automaton stringAutomaton;
-            Automaton operatorAutomaton;
-            Automaton separatorAutomaton;
+            static constexpr size_t NoSave = static_cast<size_t>(-1);
 
             // Methods
-            void initialize();
+            Checkpoint scanCheckpoint() const;
+            bool recentlySaved() const;
+            LiteralTable& literalSink() { return externalLiterals ? *externalLiterals : literalTable; }
+            void bufferToken();
+            TokenView scanNext();
+            TokenView scanToken();
+            TokenView scanAutomaton(const Automaton& automaton);
+            TokenType classify(std::string_view lexeme, const Automaton& automaton) const;
+            size_t matchUtf8Transition(const Automaton& automaton, State currentState, State& nextState) const;
             void skipWhitespaceAndComments();
-            void initializeAutomata();
-            void populateIdentifierTransitions();
-            void populateNumberTransitions();
-            void populateStringTransitions();
-            void populateOperatorTransitions();
-            void populateSeparatorTransitions();
             void reportError(const std::string& message);
 
             char peekChar(int offset) const;
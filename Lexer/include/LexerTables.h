@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ILexer.h"
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+namespace CPPCompiler {
+    namespace Lexer {
+
+        // Transparent hash so keyword lookups can take a std::string_view without allocating.
+        struct StringHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view text) const noexcept {
+                return std::hash<std::string_view>{}(text);
+            }
+        };
+
+        // Keyword/operator/separator sets and the token automata. They never change
+        // after construction, so one instance is built lazily and shared by all lexers.
+        class LexerTables {
+        public:
+            static const LexerTables& shared();
+
+            std::unordered_set<std::string, StringHash, std::equal_to<>> keywords;
+            std::unordered_set<std::string> operators;
+            std::unordered_set<std::string> separators;
+
+            Automaton identifierAutomaton;
+            Automaton numberAutomaton;
+            Automaton stringAutomaton;
+            Automaton operatorAutomaton;
+            Automaton separatorAutomaton;
+
+        private:
+            LexerTables();
+
+            void initialize();
+            void initializeAutomata();
+            void populateIdentifierTransitions();
+            void populateNumberTransitions();
+            void populateStringTransitions();
+            void populateOperatorTransitions();
+            void populateSeparatorTransitions();
+        };
+
+    }
+}
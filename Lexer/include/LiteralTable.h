@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace CPPCompiler {
+    namespace Lexer {
+
+        enum class LiteralKind {
+            Integer,
+            Floating,
+            String,
+            Character
+        };
+
+        // Value of a numeric, string or character literal, decoded once by the lexer.
+        struct LiteralValue {
+            LiteralKind kind = LiteralKind::Integer;
+            uint64_t integer = 0;        // Integer and Character literals
+            double floating = 0.0;       // Floating literals
+            std::string_view text;       // String literals: unescaped bytes, owned by the table
+            bool isUnsigned = false;     // 'u' suffix
+            unsigned char longCount = 0; // 'l' = 1, 'll' = 2; 'l' on a floating literal means long double
+            bool isFloat = false;        // 'f' suffix
+            bool valid = true;           // False on overflow, malformed digits/suffix or a bad escape
+        };
+
+        // Bump allocator for unescaped string contents. Chunks never move, so the
+        // string_views handed out stay valid until the arena is reset or destroyed.
+        class StringArena {
+        public:
+            char* allocate(size_t size);
+            // Returns the unused tail of the most recent allocation.
+            void shrinkLast(size_t unusedBytes);
+            // Invalidates every allocation but keeps the chunks for reuse.
+            void reset();
+
+        private:
+            static constexpr size_t ChunkSize = 16 * 1024;
+
+            struct Chunk {
+                std::unique_ptr<char[]> data;
+                size_t capacity;
+            };
+
+            std::vector<Chunk> chunks;
+            size_t current = 0; // Chunk being filled
+            size_t chunkUsed = 0;
+        };
+
+        // Side table of decoded literal values; tokens refer to entries by index.
+        class LiteralTable {
+        public:
+            // Decode a lexeme accepted by the number / string automaton and append it.
+            size_t addNumber(std::string_view lexeme);
+            size_t addQuoted(std::string_view lexeme);
+
+            const LiteralValue& operator[](size_t index) const { return values[index]; }
+            size_t size() const { return values.size(); }
+
+            void reserve(size_t count) { values.reserve(count); }
+            // Drops every entry, keeping the allocated storage for reuse.
+            void clear();
+
+        private:
+            std::vector<LiteralValue> values;
+            StringArena arena;
+        };
+
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Lexer.h"
+#include "SpscQueue.h"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace CPPCompiler {
+    namespace Lexer {
+
+        // A fixed-capacity run of tokens handed from the lexer thread to the consumer.
+        // Lexemes are views into the PipelinedLexer's copy of the source.
+        // The batch holding the EndOfFile token is marked as the last one.
+        struct TokenBatch {
+            std::vector<TokenView> tokens;
+            // Decoded values for this batch's literals; literalIndex is relative to the batch.
+            // The table is cleared, not freed, when the batch is refilled.
+            LiteralTable literals;
+            bool isLast = false;
+
+            // Value of a Literal token from this batch.
+            const LiteralValue& literal(const TokenView& token) const { return literals[token.literalIndex]; }
+        };
+
+        // Runs a Lexer on its own thread and publishes tokens in batches through a
+        // lock-free SPSC queue, so downstream stages overlap with lexing.
+        // Batches are preallocated and recycled through a second queue; the lexer
+        // thread blocks when the consumer holds all of them (backpressure).
+        // Either side spins briefly on an empty queue, then sleeps on an atomic wait.
+        class PipelinedLexer {
+        public:
+            static constexpr size_t BatchSize = 256;
+            static constexpr size_t BatchCount = 8;
+
+            explicit PipelinedLexer(const std::string& source);
+            // Lexer errors go to diagnostics, written from the lexer thread.
+            PipelinedLexer(const std::string& source, std::ostream& diagnostics);
+            ~PipelinedLexer();
+
+            PipelinedLexer(const PipelinedLexer&) = delete;
+            PipelinedLexer& operator=(const PipelinedLexer&) = delete;
+
+            // Waits for the next published batch. Returns nullptr once the last
+            // batch has been handed out. Every batch must be given back with releaseBatch().
+            const TokenBatch* acquireBatch();
+            void releaseBatch(const TokenBatch* batch);
+
+            // Calls consumer(const TokenView&) for every token up to and including EndOfFile.
+            template <typename Consumer>
+            void forEachToken(Consumer&& consumer) {
+                while (const TokenBatch* batch = acquireBatch()) {
+                    for (const TokenView& token : batch->tokens) {
+                        consumer(token);
+                    }
+                    releaseBatch(batch);
+                }
+            }
+
+        private:
+            void produce();
+
+            Lexer lexer;
+            std::array<TokenBatch, BatchCount> batches;
+            SpscQueue<TokenBatch*, BatchCount> readyBatches;
+            SpscQueue<TokenBatch*, BatchCount> freeBatches;
+            std::atomic<uint32_t> readySignal; // Bumped after every push, to wake a waiting pop
+            std::atomic<uint32_t> freeSignal;
+            std::atomic<bool> stopRequested;
+            bool finished;
+            std::thread producer;
+        };
+
+    }
+}
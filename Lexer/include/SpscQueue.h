@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4324) // Structure padded due to alignment specifier (intended)
+#endif
+
+namespace CPPCompiler {
+    namespace Lexer {
+
+        // Bounded lock-free queue for exactly one producer thread and one consumer thread.
+        // Head and tail are free-running counters, so all Capacity slots are usable.
+        template <typename T, size_t Capacity>
+        class SpscQueue {
+            static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+        public:
+            // Producer side. Returns false when the queue is full.
+            bool tryPush(const T& item) {
+                size_t tail = tailIndex.load(std::memory_order_relaxed);
+                if (tail - headIndex.load(std::memory_order_acquire) == Capacity) {
+                    return false;
+                }
+                slots[tail & (Capacity - 1)] = item;
+                tailIndex.store(tail + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Consumer side. Returns false when the queue is empty.
+            bool tryPop(T& item) {
+                size_t head = headIndex.load(std::memory_order_relaxed);
+                if (head == tailIndex.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                item = slots[head & (Capacity - 1)];
+                headIndex.store(head + 1, std::memory_order_release);
+                return true;
+            }
+
+        private:
+            // Keep the two indices on separate cache lines so producer and consumer don't false-share.
+            static constexpr size_t CacheLineSize = 64;
+
+            alignas(CacheLineSize) std::atomic<size_t> headIndex{ 0 };
+            alignas(CacheLineSize) std::atomic<size_t> tailIndex{ 0 };
+            alignas(CacheLineSize) std::array<T, Capacity> slots{};
+        };
+
+    }
+}
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
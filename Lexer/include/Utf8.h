@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace CPPCompiler {
+    namespace Lexer {
+        namespace Utf8 {
+
+            // True when every byte is below 0x80. Checks 16 bytes per step where SSE2
+            // is available and 8 bytes per step otherwise.
+            bool isAscii(std::string_view text);
+
+            // Decodes one well-formed UTF-8 sequence starting at text[position].
+            // Returns its length in bytes, or 0 for truncated, overlong, surrogate
+            // or out-of-range sequences.
+            size_t decode(std::string_view text, size_t position, char32_t& codePoint);
+
+            // Writes the UTF-8 encoding of a scalar value to out (room for 4 bytes).
+            // Returns the number of bytes written, or 0 for surrogates and values above U+10FFFF.
+            size_t encode(char32_t codePoint, char* out);
+
+            // Unicode identifier properties (UAX #31) for non-ASCII code points.
+            bool isXidStart(char32_t codePoint);
+            bool isXidContinue(char32_t codePoint);
+
+            inline bool isContinuationByte(char ch) {
+                return (static_cast<unsigned char>(ch) & 0xC0) == 0x80;
+            }
+
+            inline bool isNonAscii(char ch) {
+                return static_cast<unsigned char>(ch) >= 0x80;
+            }
+
+        }
+    }
+}
@@ -1,88 +1,117 @@
 #include "Lexer.h"
+#include "Utf8.h"
+#include <algorithm>
 #include <cctype>
-#include <unordered_set>
+#include <stdexcept>
 #include <iostream> // For reportError method
 
 namespace CPPCompiler {
     namespace Lexer {
 
         Lexer::Lexer(const std::string& source)
-            : sourceBuffer(source), currentPosition(0), line(1), column(1) {
-            initialize();
-            initializeAutomata();
+            : sourceBuffer(source), currentPosition(0), line(1), column(1),
+              asciiOnly(Utf8::isAscii(source)), diagnostics(&std::cerr), tables(LexerTables::shared()),
+              externalLiterals(nullptr), consumedCount(0), lexedCount(0), historyStart(0),
+              scannedCount(0), nextLiteral(0), replaying(false), lastSaveIndex(NoSave) {
         }
 
-        void Lexer::initialize() {
-            // Initialize keyword,operator and separators sets
-            keywords = {
-                "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const", "consteval", "constexpr", "constinit", "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq"
-            };
-
-            operators = {
-                // Arithmetic Operators
-                "+", "-", "*", "/", "%",
-                // Increment and Decrement Operators
-                "++", "--",
-                // Relational Operators
-                "==", "!=", "<", ">", "<=", ">=",
-                // Logical Operators
-                "&&", "||", "!",
-                // Bitwise Operators
-                "&", "|", "^", "~", "<<", ">>",
-                // Assignment Operators
-                "=", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<=", ">>=",
-                // Member and Pointer Operators
-                ".", "->", ".*", "->*",
-                // Conditional Operator
-                "?", ":",
-                // Scope Resolution Operator
-                "::",
-                // Three-Way Comparison Operator
-                "<=>",
-                // Other Operators
-                "::", ".*", "->*"
-            };
-
-            separators = {
-                ";", ",", "(", ")", "{", "}", "[", "]", ":", "...", "->", ".*", "->*"
-            };
+        Token Lexer::getNextToken() {
+            if (consumedCount == lexedCount && !recentlySaved()) {
+                // Nothing buffered and no checkpoint to rewind to cheaply: skip the ring.
+                // Its slots are now stale, so a later restore() rewinds the scanner.
+                TokenView token = scanNext();
+                consumedCount = historyStart = lexedCount;
+                return Token{ token.type, std::string(token.lexeme), token.line, token.column, token.literalIndex };
+            }
+            if (consumedCount == lexedCount) {
+                bufferToken();
+            }
+            return lookahead[consumedCount++ % LookaheadCapacity].token;
         }
 
-        void Lexer::initializeAutomata() {
-            // Initialize Identifier Automaton
-            identifierAutomaton.startState = 0;
-            identifierAutomaton.acceptingStates = { 1 };
-            populateIdentifierTransitions();
-
-            // Initialize Number Automaton
-            numberAutomaton.startState = 0;
-            numberAutomaton.acceptingStates = { 1, 3, 6 }; // Accept integers, decimals, exponents
-            populateNumberTransitions();
-
-            // Initialize String Automaton
-            stringAutomaton.startState = 0;
-            stringAutomaton.acceptingStates = { 2 };
-            populateStringTransitions();
-
-            // Initialize Operator Automaton
-            operatorAutomaton.startState = 0;
-            // Accepting states will be set during population
-            populateOperatorTransitions();
-
-            // Initialize Separator Automaton
-            separatorAutomaton.startState = 0;
-            separatorAutomaton.acceptingStates = { 1 };
-            populateSeparatorTransitions();
+        const Token& Lexer::peekToken(size_t k) {
+            if (k >= LookaheadCapacity) {
+                throw std::out_of_range("peekToken: lookahead is limited to " + std::to_string(LookaheadCapacity - 1));
+            }
+            while (lexedCount - consumedCount <= k) {
+                bufferToken();
+            }
+            return lookahead[(consumedCount + k) % LookaheadCapacity].token;
         }
 
-        Token Lexer::getNextToken() {
+        Checkpoint Lexer::save() {
+            lastSaveIndex = consumedCount;
+            // Buffered tokens haven't been consumed yet, so the logical position is
+            // the scanner state from before the first of them.
+            if (consumedCount < lexedCount) {
+                return lookahead[consumedCount % LookaheadCapacity].before;
+            }
+            return scanCheckpoint();
+        }
+
+        void Lexer::restore(const Checkpoint& checkpoint) {
+            size_t oldestBuffered = std::max(historyStart, lexedCount > LookaheadCapacity ? lexedCount - LookaheadCapacity : 0);
+            if (checkpoint.tokenIndex >= oldestBuffered && checkpoint.tokenIndex <= lexedCount) {
+                consumedCount = checkpoint.tokenIndex;
+                return;
+            }
+
+            // Earlier or later than the ring (a later one was saved before an earlier rewind).
+            // Literal entries are never dropped, so the checkpoint's scanner state is all we need.
+            currentPosition = checkpoint.position;
+            line = checkpoint.line;
+            column = checkpoint.column;
+            nextLiteral = checkpoint.literalCount;
+            consumedCount = lexedCount = historyStart = checkpoint.tokenIndex;
+        }
+
+        // True while the latest checkpoint is close enough that restoring it can be
+        // served from the ring buffer, so getNextToken() keeps filling the ring.
+        bool Lexer::recentlySaved() const {
+            return lastSaveIndex != NoSave && lexedCount < lastSaveIndex + LookaheadCapacity;
+        }
+
+        Checkpoint Lexer::scanCheckpoint() const {
+            return Checkpoint{ currentPosition, line, column, lexedCount, nextLiteral };
+        }
 
-            std::cerr <<"source buffer size is: " << sourceBuffer.size() << std::endl;
+        // Scans token number lexedCount of the getNextToken() stream. Below the high-water
+        // mark the token was scanned before a rewind, so its errors are not reported twice.
+        TokenView Lexer::scanNext() {
+            replaying = lexedCount < scannedCount;
+            TokenView token = scanToken();
+            replaying = false;
+            scannedCount = std::max(scannedCount, ++lexedCount);
+            return token;
+        }
+
+        void Lexer::bufferToken() {
+            LookaheadEntry& entry = lookahead[lexedCount % LookaheadCapacity];
+            entry.before = scanCheckpoint();
+
+            TokenView token = scanNext();
+            entry.token.type = token.type;
+            entry.token.lexeme.assign(token.lexeme); // Reuses the slot's capacity
+            entry.token.line = token.line;
+            entry.token.column = token.column;
+            entry.token.literalIndex = token.literalIndex;
+        }
 
+        Generator<TokenView> Lexer::tokens() {
+            while (true) {
+                TokenView token = scanToken();
+                if (token.type == TokenType::EndOfFile) {
+                    co_return;
+                }
+                co_yield token;
+            }
+        }
+
+        TokenView Lexer::scanToken() {
             skipWhitespaceAndComments();
 
             if (isEOF()) {
-                return Token{ TokenType::EndOfFile, "", line, column };
+                return TokenView{ TokenType::EndOfFile, std::string_view(), line, column };
             }
 
             size_t tokenLine = line;
@@ -90,43 +119,80 @@ namespace CPPCompiler {
 
             char ch = peekChar(0);
 
+            State utf8State;
             if (isIdentifierStart(ch)) {
-                return runAutomaton(identifierAutomaton);
+                return scanAutomaton(tables.identifierAutomaton);
+            }
+            else if (!asciiOnly && Utf8::isNonAscii(ch) && matchUtf8Transition(tables.identifierAutomaton, tables.identifierAutomaton.startState, utf8State)) {
+                return scanAutomaton(tables.identifierAutomaton);
             }
             else if (isDigit(ch) || (ch == '.' && isDigit(peekChar(1)))) {
-                return runAutomaton(numberAutomaton);
+                return scanAutomaton(tables.numberAutomaton);
             }
             else if (ch == '"' || ch == '\'') {
-                return runAutomaton(stringAutomaton);
+                return scanAutomaton(tables.stringAutomaton);
             }
             // 4. Ellipsis (specific separator before general operators/separators)
             else if (ch == '.' && peekChar(1) == '.' && peekChar(2) == '.') {
                 // Ensure separatorAutomaton handles '...' correctly starting from '.'
-                return runAutomaton(separatorAutomaton);
+                return scanAutomaton(tables.separatorAutomaton);
             }
             else if (isOperatorStart(ch)) {
-                return runAutomaton(operatorAutomaton);
+                return scanAutomaton(tables.operatorAutomaton);
             }
             else if (isSeparatorStart(ch)) {
-                return runAutomaton(separatorAutomaton);
+                return scanAutomaton(tables.separatorAutomaton);
             }
             else {
                 reportError("Unrecognized character");
-                std::string lexeme(1, readChar());
-                return Token{ TokenType::Unknown, lexeme, tokenLine, tokenColumn };
+                size_t startPosition = currentPosition;
+                // Consume a whole UTF-8 sequence so one stray character yields one Unknown token.
+                char32_t codePoint;
+                size_t length = Utf8::isNonAscii(ch) ? Utf8::decode(sourceBuffer, currentPosition, codePoint) : 0;
+                for (size_t i = 0; i < std::max<size_t>(length, 1); ++i) {
+                    readChar();
+                }
+                return TokenView{ TokenType::Unknown, std::string_view(sourceBuffer).substr(startPosition, currentPosition - startPosition), tokenLine, tokenColumn };
+            }
+        }
+
+        // Fallback for bytes >= 0x80, which the automata have no transitions for:
+        // identifiers accept XID_Start/XID_Continue code points and string literals
+        // accept any well-formed UTF-8 sequence. Returns the sequence length, or 0
+        // when the automaton cannot move on this input.
+        size_t Lexer::matchUtf8Transition(const Automaton& automaton, State currentState, State& nextState) const {
+            char32_t codePoint;
+            size_t length = Utf8::decode(sourceBuffer, currentPosition, codePoint);
+            if (length == 0) {
+                return 0;
+            }
+
+            if (&automaton == &tables.identifierAutomaton) {
+                bool accepted = currentState == automaton.startState ? Utf8::isXidStart(codePoint) : Utf8::isXidContinue(codePoint);
+                nextState = 1;
+                return accepted ? length : 0;
+            }
+            else if (&automaton == &tables.stringAutomaton && currentState == 1) {
+                nextState = 1;
+                return length;
             }
+            return 0;
         }
 
         Token Lexer::runAutomaton(const Automaton& automaton) {
+            TokenView token = scanAutomaton(automaton);
+            return Token{ token.type, std::string(token.lexeme), token.line, token.column, token.literalIndex };
+        }
+
+        TokenView Lexer::scanAutomaton(const Automaton& automaton) {
             State currentState = automaton.startState;
             size_t startPosition = currentPosition;
             size_t tokenLine = line;
             size_t tokenColumn = column;
-            std::string lexeme;
 
             char firstChar = peekChar(0);
             char stringTerminator = '\0';
-            if (&automaton == &stringAutomaton && (firstChar == '"' || firstChar == '\'')) {
+            if (&automaton == &tables.stringAutomaton && (firstChar == '"' || firstChar == '\'')) {
                 stringTerminator = firstChar; // Remember the type of quote
             }
 
@@ -139,12 +205,23 @@ namespace CPPCompiler {
 
                     if (charTransition != stateTransitions->second.end()) {
                         currentState = charTransition->second;
-                        lexeme += readChar();
+                        readChar();
 
                         // Special handling for string literals
-                        if (&automaton == &stringAutomaton && ch == stringTerminator && currentState == 2) {
+                        if (&automaton == &tables.stringAutomaton && ch == stringTerminator && currentState == 2) {
+                            break;
+                        }
+                    }
+                    else if (!asciiOnly && Utf8::isNonAscii(ch)) {
+                        State nextState;
+                        size_t length = matchUtf8Transition(automaton, currentState, nextState);
+                        if (length == 0) {
                             break;
                         }
+                        currentState = nextState;
+                        for (size_t i = 0; i < length; ++i) {
+                            readChar();
+                        }
                     }
                     else {
                         break;
@@ -155,31 +232,56 @@ namespace CPPCompiler {
                 }
             }
 
+            // The lexeme is always a contiguous slice of the source buffer.
+            std::string_view lexeme = std::string_view(sourceBuffer).substr(startPosition, currentPosition - startPosition);
+
             if (automaton.acceptingStates.count(currentState)) {
-                TokenType type = determineTokenType(lexeme, automaton);
-                return Token{ type, lexeme, tokenLine, tokenColumn };
+                TokenType type = classify(lexeme, automaton);
+                TokenView token{ type, lexeme, tokenLine, tokenColumn };
+
+                // Decode literal values during this scan so consumers never re-parse them.
+                if (&automaton == &tables.numberAutomaton || &automaton == &tables.stringAutomaton) {
+                    LiteralTable& literals = literalSink();
+                    if (nextLiteral < literals.size()) {
+                        token.literalIndex = nextLiteral++; // Re-scan after restore(): already decoded
+                    }
+                    else {
+                        token.literalIndex = &automaton == &tables.numberAutomaton
+                            ? literals.addNumber(lexeme)
+                            : literals.addQuoted(lexeme);
+                        nextLiteral = literals.size();
+                        if (!literals[token.literalIndex].valid) {
+                            reportError("Invalid literal: " + std::string(lexeme));
+                        }
+                    }
+                }
+                return token;
             }
             else {
-                reportError("Invalid token: " + lexeme);
+                reportError("Invalid token: " + std::string(lexeme));
                 currentPosition = startPosition + 1; // Move past the invalid character
-                return getNextToken();
+                return scanToken();
             }
         }
 
         TokenType Lexer::determineTokenType(const std::string& lexeme, const Automaton& automaton) {
-            if (&automaton == &identifierAutomaton) {
-                return keywords.count(lexeme) ? TokenType::Keyword : TokenType::Identifier;
+            return classify(lexeme, automaton);
+        }
+
+        TokenType Lexer::classify(std::string_view lexeme, const Automaton& automaton) const {
+            if (&automaton == &tables.identifierAutomaton) {
+                return tables.keywords.count(lexeme) ? TokenType::Keyword : TokenType::Identifier;
             }
-            else if (&automaton == &numberAutomaton) {
+            else if (&automaton == &tables.numberAutomaton) {
                 return TokenType::Literal;
             }
-            else if (&automaton == &stringAutomaton) {
+            else if (&automaton == &tables.stringAutomaton) {
                 return TokenType::Literal;
             }
-            else if (&automaton == &operatorAutomaton) {
+            else if (&automaton == &tables.operatorAutomaton) {
                 return TokenType::Operator;
             }
-            else if (&automaton == &separatorAutomaton) {
+            else if (&automaton == &tables.separatorAutomaton) {
                 return TokenType::Separator;
             }
             else {
@@ -187,183 +289,21 @@ namespace CPPCompiler {
             }
         }
 
-        void Lexer::populateSeparatorTransitions() {
-            // For single-character separators
-            std::unordered_set<char> singleSeparators = { ';', ',', '(', ')', '{', '}', '[', ']', ':' };
-            for (char sep : singleSeparators) {
-                separatorAutomaton.transitions[0][sep] = 1;
-            }
-
-            // For multi-character separators
-            // Handle '::', '...', '->', '.*', '->*'
-            separatorAutomaton.transitions[0][':'] = 2;
-            separatorAutomaton.transitions[2][':'] = 1; // Accept '::'
-
-            separatorAutomaton.transitions[0]['.'] = 3;
-            separatorAutomaton.transitions[3]['.'] = 4;
-            separatorAutomaton.transitions[4]['.'] = 1; // Accept '...'
-
-            separatorAutomaton.transitions[0]['-'] = 5;
-            separatorAutomaton.transitions[5]['>'] = 1; // Accept '->'
-
-            separatorAutomaton.transitions[0]['.'] = 3;
-            separatorAutomaton.transitions[3]['*'] = 1; // Accept '.*'
-
-            separatorAutomaton.transitions[5]['>'] = 6;
-            separatorAutomaton.transitions[6]['*'] = 1; // Accept '->*'
-
-            // Update accepting states if needed
-            separatorAutomaton.acceptingStates.insert(1);
-        }
-
-        void Lexer::populateIdentifierTransitions() {
-            // From State 0 to State 1: letters and '_'
-            for (char ch = 'A'; ch <= 'Z'; ++ch) {
-                identifierAutomaton.transitions[0][ch] = 1;
-                identifierAutomaton.transitions[1][ch] = 1;
-            }
-            for (char ch = 'a'; ch <= 'z'; ++ch) {
-                identifierAutomaton.transitions[0][ch] = 1;
-                identifierAutomaton.transitions[1][ch] = 1;
-            }
-            identifierAutomaton.transitions[0]['_'] = 1;
-            identifierAutomaton.transitions[1]['_'] = 1;
-
-            // From State 1 to State 1: letters, digits, and '_'
-            for (char ch = '0'; ch <= '9'; ++ch) {
-                identifierAutomaton.transitions[1][ch] = 1;
-            }
-        }
-
-        /*
-        States:
-
-        State 0: Start state.
-
-        State 1: Integer part.
-
-        State 2: Decimal point encountered.
-
-        State 3: Fractional part.
-
-        State 4: Exponent symbol encountered ('e' or 'E').
-
-        State 5: Exponent sign.
-
-        State 6: Exponent part.
-
-        State 7: Invalid state.
-        */
-
-        void Lexer::populateNumberTransitions() {
-            // Digits 0-9
-            for (char ch = '0'; ch <= '9'; ++ch) {
-                // From Start State to Integer Part
-                numberAutomaton.transitions[0][ch] = 1;
-                // Integer Part to Integer Part
-                numberAutomaton.transitions[1][ch] = 1;
-                // Fractional Part to Fractional Part
-                numberAutomaton.transitions[3][ch] = 3;
-                // Exponent Part to Exponent Part
-                numberAutomaton.transitions[6][ch] = 6;
-            }
-
-            // Decimal Point
-            numberAutomaton.transitions[1]['.'] = 2; // Integer Part to Decimal Point
-            numberAutomaton.transitions[0]['.'] = 2; // Start State to Decimal Point
-
-            // After Decimal Point
-            for (char ch = '0'; ch <= '9'; ++ch) {
-                numberAutomaton.transitions[2][ch] = 3; // Decimal Point to Fractional Part
-            }
-
-            // Exponent Symbol
-            numberAutomaton.transitions[1]['e'] = 4;
-            numberAutomaton.transitions[1]['E'] = 4;
-            numberAutomaton.transitions[3]['e'] = 4;
-            numberAutomaton.transitions[3]['E'] = 4;
-
-            // Exponent Sign
-            numberAutomaton.transitions[4]['+'] = 5;
-            numberAutomaton.transitions[4]['-'] = 5;
-
-            // Exponent Part
-            for (char ch = '0'; ch <= '9'; ++ch) {
-                numberAutomaton.transitions[5][ch] = 6; // After Exponent Sign
-                numberAutomaton.transitions[4][ch] = 6; // Directly after 'e' or 'E'
-                numberAutomaton.transitions[6][ch] = 6; // Continue Exponent Part
-            }
-        }
-
-        /*
-        States:
-
-        State 0: Start state.
-
-        State 1: Inside string.
-
-        State 2: Accepting state (end of string).
-
-        State 3: Escape character.
-
-        */
-        void Lexer::populateStringTransitions() {
-            // Opening Quotes
-            stringAutomaton.transitions[0]['"'] = 1;
-            stringAutomaton.transitions[0]['\''] = 1;
-
-            // Any character inside the string (excluding special characters)
-            for (int ch = 32; ch <= 126; ++ch) {
-                char c = static_cast<char>(ch);
-                if (c != '"' && c != '\'' && c != '\\') {
-                    stringAutomaton.transitions[1][c] = 1;
-                }
-            }
-
-            // Handling escape sequences
-            stringAutomaton.transitions[1]['\\'] = 3; // Escape character
-            // After escape character, accept any character
-            for (int ch = 0; ch <= 127; ++ch) {
-                char c = static_cast<char>(ch);
-                stringAutomaton.transitions[3][c] = 1;
-            }
-
-            // Closing Quotes
-            stringAutomaton.transitions[1]['"'] = 2;
-            stringAutomaton.transitions[1]['\''] = 2;
-        }
-
-        void Lexer::populateOperatorTransitions() {
-            operatorAutomaton.startState = 0;
-            int nextState = 1;
-
-            for (const std::string& op : operators) {
-                int currentState = operatorAutomaton.startState;
-                for (char ch : op) {
-                    if (operatorAutomaton.transitions[currentState].find(ch) == operatorAutomaton.transitions[currentState].end()) {
-                        operatorAutomaton.transitions[currentState][ch] = nextState++;
-                    }
-                    currentState = operatorAutomaton.transitions[currentState][ch];
-                }
-                operatorAutomaton.acceptingStates.insert(currentState);
-            }
-        }
-
-
         // Implementations of helper methods...
         bool Lexer::isIdentifierStart(char ch) const {
-            return std::isalpha(static_cast<unsigned char>(ch)) || ch == '_';
+            // ASCII only; non-ASCII starts go through matchUtf8Transition.
+            return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
         }
 
         bool Lexer::isOperatorStart(char ch) const {
-            auto stateTransitionsIt = operatorAutomaton.transitions.find(operatorAutomaton.startState);
-            return stateTransitionsIt != operatorAutomaton.transitions.end() &&
+            auto stateTransitionsIt = tables.operatorAutomaton.transitions.find(tables.operatorAutomaton.startState);
+            return stateTransitionsIt != tables.operatorAutomaton.transitions.end() &&
                 stateTransitionsIt->second.count(ch) > 0;
         }
 
         bool Lexer::isSeparatorStart(char ch) const {
-            auto stateTransitionsIt = separatorAutomaton.transitions.find(separatorAutomaton.startState);
-            return stateTransitionsIt != separatorAutomaton.transitions.end() &&
+            auto stateTransitionsIt = tables.separatorAutomaton.transitions.find(tables.separatorAutomaton.startState);
+            return stateTransitionsIt != tables.separatorAutomaton.transitions.end() &&
                 stateTransitionsIt->second.count(ch) > 0;
         }
 
@@ -390,8 +330,8 @@ namespace CPPCompiler {
                 line++;
                 column = 1;
             }
-            else {
-                column++;
+            else if (!Utf8::isContinuationByte(ch)) {
+                column++; // Columns count code points, not bytes
             }
             return ch;
         }
@@ -435,7 +375,10 @@ namespace CPPCompiler {
         }
 
         void Lexer::reportError(const std::string& message) {
-            std::cerr << "Lexer error at Line " << line << ", Column " << column << ": " << message << std::endl;
+            if (replaying) {
+                return;
+            }
+            *diagnostics << "Lexer error at Line " << line << ", Column " << column << ": " << message << std::endl;
         }
 
     }
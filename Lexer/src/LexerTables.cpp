@@ -0,0 +1,297 @@
+#include "LexerTables.h"
+#include <string_view>
+
+namespace CPPCompiler {
+    namespace Lexer {
+
+        const LexerTables& LexerTables::shared() {
+            // Built once per process; every Lexer (and every request in server mode) reuses it.
+            static const LexerTables instance;
+            return instance;
+        }
+
+        LexerTables::LexerTables() {
+            initialize();
+            initializeAutomata();
+        }
+
+        void LexerTables::initialize() {
+            // Initialize keyword,operator and separators sets
+            keywords = {
+                "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor", "bool", "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t", "class", "compl", "concept", "const", "consteval", "constexpr", "constinit", "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype", "default", "delete", "do", "double", "dynamic_cast", "else", "enum", "explicit", "export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept", "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected", "public", "register", "reinterpret_cast", "requires", "return", "short", "signed", "sizeof", "static", "static_assert", "static_cast", "struct", "switch", "template", "this", "thread_local", "throw", "true", "try", "typedef", "typeid", "typename", "union", "unsigned", "using", "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq"
+            };
+
+            operators = {
+                // Arithmetic Operators
+                "+", "-", "*", "/", "%",
+                // Increment and Decrement Operators
+                "++", "--",
+                // Relational Operators
+                "==", "!=", "<", ">", "<=", ">=",
+                // Logical Operators
+                "&&", "||", "!",
+                // Bitwise Operators
+                "&", "|", "^", "~", "<<", ">>",
+                // Assignment Operators
+                "=", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<=", ">>=",
+                // Member and Pointer Operators
+                ".", "->", ".*", "->*",
+                // Conditional Operator
+                "?", ":",
+                // Scope Resolution Operator
+                "::",
+                // Three-Way Comparison Operator
+                "<=>",
+                // Other Operators
+                "::", ".*", "->*"
+            };
+
+            separators = {
+                ";", ",", "(", ")", "{", "}", "[", "]", ":", "...", "->", ".*", "->*"
+            };
+        }
+
+        void LexerTables::initializeAutomata() {
+            // Initialize Identifier Automaton
+            identifierAutomaton.startState = 0;
+            identifierAutomaton.acceptingStates = { 1 };
+            populateIdentifierTransitions();
+
+            // Initialize Number Automaton
+            numberAutomaton.startState = 0;
+            numberAutomaton.acceptingStates = { 1, 2, 3, 6, 7, 9, 11, 17, 18 }; // Accept integers, decimals, exponents, prefixed and suffixed forms
+            populateNumberTransitions();
+
+            // Initialize String Automaton
+            stringAutomaton.startState = 0;
+            stringAutomaton.acceptingStates = { 2 };
+            populateStringTransitions();
+
+            // Initialize Operator Automaton
+            operatorAutomaton.startState = 0;
+            // Accepting states will be set during population
+            populateOperatorTransitions();
+
+            // Initialize Separator Automaton
+            separatorAutomaton.startState = 0;
+            separatorAutomaton.acceptingStates = { 1 };
+            populateSeparatorTransitions();
+        }
+
+        void LexerTables::populateSeparatorTransitions() {
+            // For single-character separators
+            std::unordered_set<char> singleSeparators = { ';', ',', '(', ')', '{', '}', '[', ']', ':' };
+            for (char sep : singleSeparators) {
+                separatorAutomaton.transitions[0][sep] = 1;
+            }
+
+            // For multi-character separators
+            // Handle '::', '...', '->', '.*', '->*'
+            separatorAutomaton.transitions[0][':'] = 2;
+            separatorAutomaton.transitions[2][':'] = 1; // Accept '::'
+
+            separatorAutomaton.transitions[0]['.'] = 3;
+            separatorAutomaton.transitions[3]['.'] = 4;
+            separatorAutomaton.transitions[4]['.'] = 1; // Accept '...'
+
+            separatorAutomaton.transitions[0]['-'] = 5;
+            separatorAutomaton.transitions[5]['>'] = 1; // Accept '->'
+
+            separatorAutomaton.transitions[0]['.'] = 3;
+            separatorAutomaton.transitions[3]['*'] = 1; // Accept '.*'
+
+            separatorAutomaton.transitions[5]['>'] = 6;
+            separatorAutomaton.transitions[6]['*'] = 1; // Accept '->*'
+
+            // Update accepting states if needed
+            separatorAutomaton.acceptingStates.insert(1);
+        }
+
+        void LexerTables::populateIdentifierTransitions() {
+            // From State 0 to State 1: letters and '_'
+            for (char ch = 'A'; ch <= 'Z'; ++ch) {
+                identifierAutomaton.transitions[0][ch] = 1;
+                identifierAutomaton.transitions[1][ch] = 1;
+            }
+            for (char ch = 'a'; ch <= 'z'; ++ch) {
+                identifierAutomaton.transitions[0][ch] = 1;
+                identifierAutomaton.transitions[1][ch] = 1;
+            }
+            identifierAutomaton.transitions[0]['_'] = 1;
+            identifierAutomaton.transitions[1]['_'] = 1;
+
+            // From State 1 to State 1: letters, digits, and '_'
+            for (char ch = '0'; ch <= '9'; ++ch) {
+                identifierAutomaton.transitions[1][ch] = 1;
+            }
+        }
+
+        /*
+        States:
+
+        State 0: Start state.
+
+        State 1: Integer part.
+
+        State 2: Decimal point encountered (accepting: '1.' is a complete literal;
+        a leading '.' is only lexed as a number when a digit follows).
+
+        State 3: Fractional part.
+
+        State 4: Exponent symbol encountered ('e' or 'E').
+
+        State 5: Exponent sign.
+
+        State 6: Exponent part.
+
+        State 7: Leading zero (octal digits, '0x' or '0b' may follow).
+
+        State 8: Hexadecimal prefix '0x'.
+
+        State 9: Hexadecimal digits.
+
+        State 10: Binary prefix '0b'.
+
+        State 11: Binary digits.
+
+        States 12-16: Digit separator (') in integer, hexadecimal, binary,
+        fractional and exponent digits; a digit of the same kind must follow.
+
+        State 17: Integer suffix ('u', 'l', 'll' and combinations).
+
+        State 18: Floating suffix ('f' or 'l').
+        */
+
+        void LexerTables::populateNumberTransitions() {
+            auto& transitions = numberAutomaton.transitions;
+
+            // Digits 0-9
+            for (char ch = '0'; ch <= '9'; ++ch) {
+                // From Start State to Integer Part ('0' goes to Leading Zero below)
+                transitions[0][ch] = 1;
+                // Integer Part to Integer Part (octal digits are validated when decoding)
+                transitions[1][ch] = 1;
+                transitions[7][ch] = 1;
+                transitions[12][ch] = 1;
+                // Decimal Point to Fractional Part, Fractional Part to Fractional Part
+                transitions[2][ch] = 3;
+                transitions[3][ch] = 3;
+                transitions[15][ch] = 3;
+                // Exponent Part
+                transitions[4][ch] = 6; // Directly after 'e' or 'E'
+                transitions[5][ch] = 6; // After Exponent Sign
+                transitions[6][ch] = 6; // Continue Exponent Part
+                transitions[16][ch] = 6;
+            }
+            transitions[0]['0'] = 7;
+
+            // Decimal Point
+            transitions[0]['.'] = 2; // Start State to Decimal Point
+            transitions[1]['.'] = 2; // Integer Part to Decimal Point
+            transitions[7]['.'] = 2;
+
+            // Exponent Symbol
+            for (State from : { 1, 2, 3, 7 }) {
+                transitions[from]['e'] = 4;
+                transitions[from]['E'] = 4;
+            }
+
+            // Exponent Sign
+            transitions[4]['+'] = 5;
+            transitions[4]['-'] = 5;
+
+            // Hexadecimal: 0x / 0X followed by hex digits
+            transitions[7]['x'] = 8;
+            transitions[7]['X'] = 8;
+            for (char ch : std::string_view("0123456789abcdefABCDEF")) {
+                transitions[8][ch] = 9;
+                transitions[9][ch] = 9;
+                transitions[13][ch] = 9;
+            }
+
+            // Binary: 0b / 0B followed by 0 and 1
+            transitions[7]['b'] = 10;
+            transitions[7]['B'] = 10;
+            for (char ch : { '0', '1' }) {
+                transitions[10][ch] = 11;
+                transitions[11][ch] = 11;
+                transitions[14][ch] = 11;
+            }
+
+            // Digit separators
+            transitions[1]['\''] = 12;
+            transitions[7]['\''] = 12;
+            transitions[9]['\''] = 13;
+            transitions[11]['\''] = 14;
+            transitions[3]['\''] = 15;
+            transitions[6]['\''] = 16;
+
+            // Suffixes (combinations are validated when decoding)
+            for (char ch : { 'u', 'U', 'l', 'L' }) {
+                for (State from : { 1, 7, 9, 11, 17 }) {
+                    transitions[from][ch] = 17;
+                }
+            }
+            for (char ch : { 'f', 'F', 'l', 'L' }) {
+                transitions[2][ch] = 18;
+                transitions[3][ch] = 18;
+                transitions[6][ch] = 18;
+            }
+        }
+
+        /*
+        States:
+
+        State 0: Start state.
+
+        State 1: Inside string.
+
+        State 2: Accepting state (end of string).
+
+        State 3: Escape character.
+
+        */
+        void LexerTables::populateStringTransitions() {
+            // Opening Quotes
+            stringAutomaton.transitions[0]['"'] = 1;
+            stringAutomaton.transitions[0]['\''] = 1;
+
+            // Any character inside the string (excluding special characters)
+            for (int ch = 32; ch <= 126; ++ch) {
+                char c = static_cast<char>(ch);
+                if (c != '"' && c != '\'' && c != '\\') {
+                    stringAutomaton.transitions[1][c] = 1;
+                }
+            }
+
+            // Handling escape sequences
+            stringAutomaton.transitions[1]['\\'] = 3; // Escape character
+            // After escape character, accept any character
+            for (int ch = 0; ch <= 127; ++ch) {
+                char c = static_cast<char>(ch);
+                stringAutomaton.transitions[3][c] = 1;
+            }
+
+            // Closing Quotes
+            stringAutomaton.transitions[1]['"'] = 2;
+            stringAutomaton.transitions[1]['\''] = 2;
+        }
+
+        void LexerTables::populateOperatorTransitions() {
+            operatorAutomaton.startState = 0;
+            int nextState = 1;
+
+            for (const std::string& op : operators) {
+                int currentState = operatorAutomaton.startState;
+                for (char ch : op) {
+                    if (operatorAutomaton.transitions[currentState].find(ch) == operatorAutomaton.transitions[currentState].end()) {
+                        operatorAutomaton.transitions[currentState][ch] = nextState++;
+                    }
+                    currentState = operatorAutomaton.transitions[currentState][ch];
+                }
+                operatorAutomaton.acceptingStates.insert(currentState);
+            }
+        }
+
+    }
+}
@@ -0,0 +1,274 @@
+#include "LiteralTable.h"
+#include "Utf8.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+namespace CPPCompiler {
+    namespace Lexer {
+
+        namespace {
+
+            bool isHexDigit(char ch) {
+                return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F');
+            }
+
+            unsigned hexValue(char ch) {
+                if (ch >= '0' && ch <= '9') return static_cast<unsigned>(ch - '0');
+                if (ch >= 'a' && ch <= 'f') return static_cast<unsigned>(ch - 'a' + 10);
+                return static_cast<unsigned>(ch - 'A' + 10);
+            }
+
+            // Runs convert on the digits with any ' separators removed. Only allocates
+            // when the literal actually contains separators.
+            template <typename Convert>
+            bool withoutSeparators(std::string_view digits, Convert&& convert) {
+                if (digits.find('\'') == std::string_view::npos) {
+                    return convert(digits);
+                }
+                std::string stripped;
+                stripped.reserve(digits.size());
+                std::copy_if(digits.begin(), digits.end(), std::back_inserter(stripped), [](char ch) { return ch != '\''; });
+                return convert(std::string_view(stripped));
+            }
+
+            bool parseIntegerSuffix(std::string_view suffix, LiteralValue& value) {
+                if (!suffix.empty() && (suffix.front() == 'u' || suffix.front() == 'U')) {
+                    value.isUnsigned = true;
+                    suffix.remove_prefix(1);
+                }
+                else if (!suffix.empty() && (suffix.back() == 'u' || suffix.back() == 'U')) {
+                    value.isUnsigned = true;
+                    suffix.remove_suffix(1);
+                }
+
+                if (suffix.empty()) {
+                    return true;
+                }
+                if (suffix == "l" || suffix == "L") {
+                    value.longCount = 1;
+                    return true;
+                }
+                if (suffix == "ll" || suffix == "LL") {
+                    value.longCount = 2;
+                    return true;
+                }
+                return false;
+            }
+
+            bool parseFloatingSuffix(std::string_view suffix, LiteralValue& value) {
+                if (suffix.empty()) {
+                    return true;
+                }
+                if (suffix == "f" || suffix == "F") {
+                    value.isFloat = true;
+                    return true;
+                }
+                if (suffix == "l" || suffix == "L") {
+                    value.longCount = 1;
+                    return true;
+                }
+                return false;
+            }
+
+            // Reads up to maxDigits hex digits starting at body[i].
+            bool readHex(std::string_view body, size_t& i, size_t minDigits, size_t maxDigits, uint32_t& result) {
+                size_t digits = 0;
+                result = 0;
+                while (i < body.size() && digits < maxDigits && isHexDigit(body[i])) {
+                    result = (result << 4) | hexValue(body[i]);
+                    ++digits;
+                    ++i;
+                }
+                return digits >= minDigits;
+            }
+
+            // Writes the unescaped form of body to out. Never writes more than
+            // body.size() bytes, since every escape is at least as long as its value.
+            size_t unescape(std::string_view body, char* out, bool& valid) {
+                size_t written = 0;
+                size_t i = 0;
+                while (i < body.size()) {
+                    char ch = body[i++];
+                    if (ch != '\\') {
+                        out[written++] = ch;
+                        continue;
+                    }
+                    if (i >= body.size()) {
+                        valid = false;
+                        break;
+                    }
+
+                    char escape = body[i++];
+                    switch (escape) {
+                    case 'n': out[written++] = '\n'; break;
+                    case 't': out[written++] = '\t'; break;
+                    case 'r': out[written++] = '\r'; break;
+                    case 'a': out[written++] = '\a'; break;
+                    case 'b': out[written++] = '\b'; break;
+                    case 'f': out[written++] = '\f'; break;
+                    case 'v': out[written++] = '\v'; break;
+                    case '\\': case '\'': case '"': case '?':
+                        out[written++] = escape;
+                        break;
+                    case 'x': {
+                        // Consumes every following hex digit, as the standard does; saturates past 0xFF.
+                        uint32_t code = 0;
+                        size_t start = i;
+                        while (i < body.size() && isHexDigit(body[i])) {
+                            code = std::min<uint32_t>((code << 4) | hexValue(body[i++]), 0x100);
+                        }
+                        if (i == start || code > 0xFF) {
+                            valid = false;
+                        }
+                        out[written++] = static_cast<char>(code & 0xFF);
+                        break;
+                    }
+                    case 'u':
+                    case 'U': {
+                        uint32_t code = 0;
+                        size_t digits = escape == 'u' ? 4 : 8;
+                        if (!readHex(body, i, digits, digits, code)) {
+                            valid = false;
+                            break;
+                        }
+                        size_t length = Utf8::encode(static_cast<char32_t>(code), out + written);
+                        if (length == 0) {
+                            valid = false;
+                        }
+                        written += length;
+                        break;
+                    }
+                    default:
+                        if (escape >= '0' && escape <= '7') {
+                            // Up to three octal digits
+                            uint32_t code = static_cast<uint32_t>(escape - '0');
+                            for (int digits = 1; digits < 3 && i < body.size() && body[i] >= '0' && body[i] <= '7'; ++digits) {
+                                code = (code << 3) | static_cast<uint32_t>(body[i++] - '0');
+                            }
+                            if (code > 0xFF) {
+                                valid = false;
+                            }
+                            out[written++] = static_cast<char>(code & 0xFF);
+                        }
+                        else {
+                            valid = false;
+                            out[written++] = escape;
+                        }
+                        break;
+                    }
+                }
+                return written;
+            }
+
+        }
+
+        char* StringArena::allocate(size_t size) {
+            // Move on to the next kept chunk before allocating a new one.
+            while (current < chunks.size() && size > chunks[current].capacity - chunkUsed) {
+                ++current;
+                chunkUsed = 0;
+            }
+            if (current == chunks.size()) {
+                size_t capacity = std::max(size, ChunkSize);
+                chunks.push_back(Chunk{ std::unique_ptr<char[]>(new char[capacity]), capacity });
+            }
+            char* result = chunks[current].data.get() + chunkUsed;
+            chunkUsed += size;
+            return result;
+        }
+
+        void StringArena::shrinkLast(size_t unusedBytes) {
+            chunkUsed -= unusedBytes;
+        }
+
+        void StringArena::reset() {
+            current = 0;
+            chunkUsed = 0;
+        }
+
+        void LiteralTable::clear() {
+            values.clear();
+            arena.reset();
+        }
+
+        size_t LiteralTable::addNumber(std::string_view lexeme) {
+            LiteralValue value;
+
+            bool isHex = lexeme.size() > 1 && lexeme[0] == '0' && (lexeme[1] == 'x' || lexeme[1] == 'X');
+            bool isBinary = lexeme.size() > 1 && lexeme[0] == '0' && (lexeme[1] == 'b' || lexeme[1] == 'B');
+            bool isFloating = !isHex && lexeme.find_first_of(".eE") != std::string_view::npos;
+
+            // Split off the suffix. Hex digits include 'f', but hex literals are never floating here.
+            auto isSuffixChar = [isFloating](char ch) {
+                return isFloating
+                    ? (ch == 'f' || ch == 'F' || ch == 'l' || ch == 'L')
+                    : (ch == 'u' || ch == 'U' || ch == 'l' || ch == 'L');
+            };
+            size_t end = lexeme.size();
+            while (end > 0 && isSuffixChar(lexeme[end - 1])) {
+                --end;
+            }
+            std::string_view digits = lexeme.substr(0, end);
+            std::string_view suffix = lexeme.substr(end);
+
+            if (isFloating) {
+                value.kind = LiteralKind::Floating;
+                value.valid = parseFloatingSuffix(suffix, value)
+                    && withoutSeparators(digits, [&value](std::string_view text) {
+                        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value.floating);
+                        return ec == std::errc() && ptr == text.data() + text.size();
+                    });
+            }
+            else {
+                int base = 10;
+                if (isHex || isBinary) {
+                    base = isHex ? 16 : 2;
+                    digits.remove_prefix(2);
+                }
+                else if (digits.size() > 1 && digits[0] == '0') {
+                    base = 8;
+                    digits.remove_prefix(1);
+                }
+
+                value.kind = LiteralKind::Integer;
+                value.valid = parseIntegerSuffix(suffix, value)
+                    && withoutSeparators(digits, [&value, base](std::string_view text) {
+                        auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value.integer, base);
+                        return ec == std::errc() && ptr == text.data() + text.size();
+                    });
+            }
+
+            values.push_back(value);
+            return values.size() - 1;
+        }
+
+        size_t LiteralTable::addQuoted(std::string_view lexeme) {
+            LiteralValue value;
+            value.kind = lexeme.front() == '\'' ? LiteralKind::Character : LiteralKind::String;
+
+            std::string_view body = lexeme.substr(1, lexeme.size() - 2);
+            char* buffer = arena.allocate(body.size());
+            size_t length = unescape(body, buffer, value.valid);
+            arena.shrinkLast(body.size() - length);
+            value.text = std::string_view(buffer, length);
+
+            if (value.kind == LiteralKind::Character) {
+                // Multi-byte character literals combine their bytes big-endian, as GCC and Clang do.
+                if (length == 0 || length > sizeof(value.integer)) {
+                    value.valid = false;
+                }
+                for (char ch : value.text) {
+                    value.integer = (value.integer << 8) | static_cast<unsigned char>(ch);
+                }
+            }
+
+            values.push_back(value);
+            return values.size() - 1;
+        }
+
+    }
+}
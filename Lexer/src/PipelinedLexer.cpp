@@ -0,0 +1,114 @@
+#include "PipelinedLexer.h"
+#include <iostream>
+
+namespace CPPCompiler {
+    namespace Lexer {
+
+        namespace {
+
+            // Failed pops before falling back to waiting on the signal.
+            constexpr int SpinCount = 64;
+
+            // Pops a batch, sleeping on signal once the short spin runs out. Reloading
+            // signal before the last tryPop means a push made after it always wakes us.
+            // Returns false if stopped() turns true first.
+            template <typename Queue, typename Stopped>
+            bool popOrWait(Queue& queue, std::atomic<uint32_t>& signal, TokenBatch*& batch, Stopped&& stopped) {
+                for (int spin = 0; spin < SpinCount; ++spin) {
+                    if (queue.tryPop(batch)) {
+                        return true;
+                    }
+                }
+                while (true) {
+                    uint32_t seen = signal.load(std::memory_order_acquire);
+                    if (queue.tryPop(batch)) {
+                        return true;
+                    }
+                    if (stopped()) {
+                        return false;
+                    }
+                    signal.wait(seen, std::memory_order_acquire);
+                }
+            }
+
+            template <typename Queue>
+            void pushAndNotify(Queue& queue, std::atomic<uint32_t>& signal, TokenBatch* batch) {
+                // Never fails: there are only BatchCount batches in circulation.
+                queue.tryPush(batch);
+                signal.fetch_add(1, std::memory_order_release);
+                signal.notify_one();
+            }
+
+        }
+
+        PipelinedLexer::PipelinedLexer(const std::string& source)
+            : PipelinedLexer(source, std::cerr) {
+        }
+
+        PipelinedLexer::PipelinedLexer(const std::string& source, std::ostream& diagnostics)
+            : lexer(source), readySignal(0), freeSignal(0), stopRequested(false), finished(false) {
+            lexer.setDiagnostics(diagnostics);
+            // Allocate all batch storage up front; nothing is allocated per batch afterwards.
+            for (TokenBatch& batch : batches) {
+                batch.tokens.reserve(BatchSize);
+                batch.literals.reserve(BatchSize);
+                freeBatches.tryPush(&batch);
+            }
+            producer = std::thread(&PipelinedLexer::produce, this);
+        }
+
+        PipelinedLexer::~PipelinedLexer() {
+            stopRequested.store(true, std::memory_order_relaxed);
+            freeSignal.fetch_add(1, std::memory_order_release);
+            freeSignal.notify_one();
+            if (producer.joinable()) {
+                producer.join();
+            }
+        }
+
+        const TokenBatch* PipelinedLexer::acquireBatch() {
+            if (finished) {
+                return nullptr;
+            }
+
+            TokenBatch* batch = nullptr;
+            popOrWait(readyBatches, readySignal, batch, [] { return false; });
+
+            finished = batch->isLast;
+            return batch;
+        }
+
+        void PipelinedLexer::releaseBatch(const TokenBatch* batch) {
+            // Hand back the mutable batch the pointer refers to.
+            TokenBatch* owned = &batches[static_cast<size_t>(batch - batches.data())];
+            pushAndNotify(freeBatches, freeSignal, owned);
+        }
+
+        void PipelinedLexer::produce() {
+            bool done = false;
+            while (!done) {
+                TokenBatch* batch = nullptr;
+                if (!popOrWait(freeBatches, freeSignal, batch, [this] { return stopRequested.load(std::memory_order_relaxed); })) {
+                    return;
+                }
+
+                // clear() keeps the reserved capacity and arena chunks, so refilling a
+                // recycled batch does not allocate, however many literals the file has.
+                batch->tokens.clear();
+                batch->literals.clear();
+                lexer.setLiteralTable(batch->literals);
+                while (batch->tokens.size() < BatchSize) {
+                    batch->tokens.push_back(lexer.nextTokenView());
+                    if (batch->tokens.back().type == TokenType::EndOfFile) {
+                        done = true;
+                        break;
+                    }
+                }
+                batch->isLast = done;
+
+                pushAndNotify(readyBatches, readySignal, batch);
+            }
+        }
+
+    }
+}
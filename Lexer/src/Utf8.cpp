@@ -0,0 +1,153 @@
+#include "Utf8.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CPPCOMPILER_HAS_SSE2 1
+#endif
+
+namespace CPPCompiler {
+    namespace Lexer {
+        namespace Utf8 {
+
+            namespace {
+
+                struct CodePointRange {
+                    char32_t first;
+                    char32_t last;
+                };
+
+#include "XidTables.inc"
+
+                template <size_t N>
+                bool inRanges(const CodePointRange(&ranges)[N], char32_t codePoint) {
+                    // First range whose upper bound is >= codePoint
+                    auto it = std::lower_bound(std::begin(ranges), std::end(ranges), codePoint,
+                        [](const CodePointRange& range, char32_t value) { return range.last < value; });
+                    return it != std::end(ranges) && it->first <= codePoint;
+                }
+
+            }
+
+            bool isAscii(std::string_view text) {
+                const char* data = text.data();
+                size_t size = text.size();
+                size_t i = 0;
+
+#ifdef CPPCOMPILER_HAS_SSE2
+                for (; i + 16 <= size; i += 16) {
+                    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+                    if (_mm_movemask_epi8(chunk) != 0) {
+                        return false;
+                    }
+                }
+#endif
+
+                // Word-at-a-time check for the remainder (or everything, without SSE2).
+                for (; i + 8 <= size; i += 8) {
+                    uint64_t word;
+                    std::memcpy(&word, data + i, sizeof(word));
+                    if (word & 0x8080808080808080ull) {
+                        return false;
+                    }
+                }
+
+                for (; i < size; ++i) {
+                    if (isNonAscii(data[i])) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            size_t decode(std::string_view text, size_t position, char32_t& codePoint) {
+                if (position >= text.size()) {
+                    return 0;
+                }
+
+                unsigned char lead = static_cast<unsigned char>(text[position]);
+                size_t length;
+                char32_t minimum;
+                if (lead < 0x80) {
+                    codePoint = lead;
+                    return 1;
+                }
+                else if ((lead & 0xE0) == 0xC0) {
+                    length = 2;
+                    minimum = 0x80;
+                    codePoint = lead & 0x1F;
+                }
+                else if ((lead & 0xF0) == 0xE0) {
+                    length = 3;
+                    minimum = 0x800;
+                    codePoint = lead & 0x0F;
+                }
+                else if ((lead & 0xF8) == 0xF0) {
+                    length = 4;
+                    minimum = 0x10000;
+                    codePoint = lead & 0x07;
+                }
+                else {
+                    return 0; // Stray continuation byte or invalid lead byte
+                }
+
+                if (position + length > text.size()) {
+                    return 0;
+                }
+
+                for (size_t i = 1; i < length; ++i) {
+                    char ch = text[position + i];
+                    if (!isContinuationByte(ch)) {
+                        return 0;
+                    }
+                    codePoint = (codePoint << 6) | (static_cast<unsigned char>(ch) & 0x3F);
+                }
+
+                if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+                    return 0;
+                }
+                return length;
+            }
+
+            size_t encode(char32_t codePoint, char* out) {
+                if (codePoint < 0x80) {
+                    out[0] = static_cast<char>(codePoint);
+                    return 1;
+                }
+                else if (codePoint < 0x800) {
+                    out[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+                    out[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    return 2;
+                }
+                else if (codePoint < 0x10000) {
+                    if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+                        return 0;
+                    }
+                    out[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+                    out[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                    out[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    return 3;
+                }
+                else if (codePoint <= 0x10FFFF) {
+                    out[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+                    out[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                    out[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                    out[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+                    return 4;
+                }
+                return 0;
+            }
+
+            bool isXidStart(char32_t codePoint) {
+                return inRanges(xidStartRanges, codePoint);
+            }
+
+            bool isXidContinue(char32_t codePoint) {
+                return inRanges(xidContinueRanges, codePoint);
+            }
+
+        }
+    }
+}
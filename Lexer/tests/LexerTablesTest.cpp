@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "LexerTables.h"
+#include <string_view>
+#include <thread>
+
+namespace CPPCompiler {
+	namespace Lexer {
+
+        namespace {
+
+            // Runs text through the automaton's ASCII transitions.
+            bool accepts(const Automaton& automaton, std::string_view text) {
+                State state = automaton.startState;
+                for (char ch : text) {
+                    auto row = automaton.transitions.find(state);
+                    if (row == automaton.transitions.end()) {
+                        return false;
+                    }
+                    auto next = row->second.find(ch);
+                    if (next == row->second.end()) {
+                        return false;
+                    }
+                    state = next->second;
+                }
+                return automaton.acceptingStates.count(state) != 0;
+            }
+
+        }
+
+        TEST(LexerTablesTest, TestSharedInstance) {
+            const LexerTables* fromOtherThread = nullptr;
+            std::thread other([&fromOtherThread] { fromOtherThread = &LexerTables::shared(); });
+            other.join();
+
+            EXPECT_EQ(&LexerTables::shared(), &LexerTables::shared());
+            EXPECT_EQ(fromOtherThread, &LexerTables::shared());
+        }
+
+        TEST(LexerTablesTest, TestWordSets) {
+            const LexerTables& tables = LexerTables::shared();
+
+            EXPECT_TRUE(tables.keywords.count("int"));
+            EXPECT_TRUE(tables.keywords.count("co_yield"));
+            EXPECT_FALSE(tables.keywords.count("main"));
+            // Transparent lookup, no std::string built
+            EXPECT_NE(tables.keywords.find(std::string_view("constexpr")), tables.keywords.end());
+
+            EXPECT_TRUE(tables.operators.count("<<="));
+            EXPECT_TRUE(tables.operators.count("->"));
+            EXPECT_TRUE(tables.separators.count(";"));
+            EXPECT_TRUE(tables.separators.count("..."));
+        }
+
+        TEST(LexerTablesTest, TestAutomata) {
+            const LexerTables& tables = LexerTables::shared();
+
+            EXPECT_TRUE(accepts(tables.identifierAutomaton, "_value1"));
+            EXPECT_FALSE(accepts(tables.identifierAutomaton, "1value"));
+
+            EXPECT_TRUE(accepts(tables.numberAutomaton, "42"));
+            EXPECT_TRUE(accepts(tables.numberAutomaton, "1."));
+            EXPECT_TRUE(accepts(tables.numberAutomaton, "1.5e-3f"));
+            EXPECT_TRUE(accepts(tables.numberAutomaton, "0x1F"));
+            EXPECT_TRUE(accepts(tables.numberAutomaton, "1'000ull"));
+            EXPECT_FALSE(accepts(tables.numberAutomaton, "0x"));
+            EXPECT_FALSE(accepts(tables.numberAutomaton, "1e"));
+
+            EXPECT_TRUE(accepts(tables.stringAutomaton, "\"a\\\"b\""));
+            EXPECT_TRUE(accepts(tables.stringAutomaton, "'c'"));
+            EXPECT_FALSE(accepts(tables.stringAutomaton, "\"open"));
+        }
+	}
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "Lexer.h"
+#include <ranges>
 #include <sstream>
 
 namespace CPPCompiler {
@@ -202,5 +203,320 @@ namespace CPPCompiler {
             Token eofToken = lexer.getNextToken();
             EXPECT_EQ(eofToken.type, TokenType::EndOfFile);
         }
+
+        TEST(LexerTest, TestGeneratorMatchesGetNextToken) {
+            std::string source = "int main() { return x + 3.14; } // trailing";
+            Lexer pullLexer(source);
+            Lexer generatorLexer(source);
+
+            size_t count = 0;
+            for (const TokenView& view : generatorLexer.tokens()) {
+                Token token = pullLexer.getNextToken();
+                EXPECT_EQ(view.type, token.type) << "Token mismatch at position " << count;
+                EXPECT_EQ(view.lexeme, token.lexeme) << "Token mismatch at position " << count;
+                EXPECT_EQ(view.line, token.line) << "Token mismatch at position " << count;
+                EXPECT_EQ(view.column, token.column) << "Token mismatch at position " << count;
+                ++count;
+            }
+
+            EXPECT_EQ(count, 11);
+            EXPECT_EQ(pullLexer.getNextToken().type, TokenType::EndOfFile);
+        }
+
+        TEST(LexerTest, TestGeneratorRangesComposition) {
+            Lexer lexer("int alpha = beta + gamma(1, delta);");
+
+            auto identifiers = lexer.tokens()
+                | std::views::filter([](const TokenView& token) { return token.type == TokenType::Identifier; })
+                | std::views::transform([](const TokenView& token) { return token.lexeme; });
+
+            std::vector<std::string_view> names;
+            for (std::string_view name : identifiers) {
+                names.push_back(name);
+            }
+
+            std::vector<std::string_view> expected = { "alpha", "beta", "gamma", "delta" };
+            EXPECT_EQ(names, expected);
+        }
+
+        TEST(LexerTest, TestGeneratorEmptySource) {
+            Lexer lexer("  // only a comment\n");
+            auto tokens = lexer.tokens();
+            EXPECT_TRUE(tokens.begin() == tokens.end());
+        }
+
+        TEST(LexerTest, TestUtf8Identifiers) {
+            // Accented Latin and Greek identifiers, spelled with explicit UTF-8 bytes
+            std::string source = "caf\xC3\xA9 = na\xC3\xAFve + \xCE\x94x;";
+            Lexer lexer(source);
+
+            Token token1 = lexer.getNextToken();
+            EXPECT_EQ(token1.type, TokenType::Identifier);
+            EXPECT_EQ(token1.lexeme, "caf\xC3\xA9");
+            EXPECT_EQ(token1.column, 1);
+
+            Token token2 = lexer.getNextToken();
+            EXPECT_EQ(token2.type, TokenType::Operator);
+            EXPECT_EQ(token2.column, 6); // Columns count code points
+
+            Token token3 = lexer.getNextToken();
+            EXPECT_EQ(token3.type, TokenType::Identifier);
+            EXPECT_EQ(token3.lexeme, "na\xC3\xAFve");
+
+            lexer.getNextToken(); // '+'
+
+            Token token5 = lexer.getNextToken();
+            EXPECT_EQ(token5.type, TokenType::Identifier);
+            EXPECT_EQ(token5.lexeme, "\xCE\x94x");
+
+            Token token6 = lexer.getNextToken();
+            EXPECT_EQ(token6.type, TokenType::Separator);
+            EXPECT_EQ(token6.column, 18);
+        }
+
+        TEST(LexerTest, TestUtf8StringLiteral) {
+            std::string source = "\"gr\xC3\xBC\xC3\x9F dich \xE2\x82\xAC\" x";
+            Lexer lexer(source);
+
+            Token token1 = lexer.getNextToken();
+            EXPECT_EQ(token1.type, TokenType::Literal);
+            EXPECT_EQ(token1.lexeme, "\"gr\xC3\xBC\xC3\x9F dich \xE2\x82\xAC\"");
+
+            Token token2 = lexer.getNextToken();
+            EXPECT_EQ(token2.type, TokenType::Identifier);
+            EXPECT_EQ(token2.column, 15);
+        }
+
+        TEST(LexerTest, TestUtf8NonIdentifierCharacter) {
+            // A Euro sign is not XID_Start: one Unknown token for the whole sequence
+            Lexer lexer("\xE2\x82\xAC x");
+
+            testing::internal::CaptureStderr();
+            Token token1 = lexer.getNextToken();
+            testing::internal::GetCapturedStderr();
+            EXPECT_EQ(token1.type, TokenType::Unknown);
+            EXPECT_EQ(token1.lexeme, "\xE2\x82\xAC");
+
+            Token token2 = lexer.getNextToken();
+            EXPECT_EQ(token2.type, TokenType::Identifier);
+            EXPECT_EQ(token2.column, 3);
+        }
+
+        TEST(LexerTest, TestDecodedLiterals) {
+            Lexer lexer("x = 0x2A + 1'000u * 2.5e1f; s = \"a\\tb\"; c = '\\n';");
+
+            std::vector<Token> literals;
+            Token token;
+            while ((token = lexer.getNextToken()).type != TokenType::EndOfFile) {
+                if (token.type == TokenType::Literal) {
+                    ASSERT_NE(token.literalIndex, NoLiteral) << token.lexeme;
+                    literals.push_back(token);
+                }
+                else {
+                    EXPECT_EQ(token.literalIndex, NoLiteral) << token.lexeme;
+                }
+            }
+
+            ASSERT_EQ(literals.size(), 5);
+            EXPECT_EQ(literals[0].lexeme, "0x2A");
+            EXPECT_EQ(lexer.literals()[literals[0].literalIndex].integer, 42u);
+
+            EXPECT_EQ(literals[1].lexeme, "1'000u");
+            EXPECT_EQ(lexer.literals()[literals[1].literalIndex].integer, 1000u);
+            EXPECT_TRUE(lexer.literals()[literals[1].literalIndex].isUnsigned);
+
+            EXPECT_EQ(literals[2].lexeme, "2.5e1f");
+            EXPECT_DOUBLE_EQ(lexer.literals()[literals[2].literalIndex].floating, 25.0);
+            EXPECT_TRUE(lexer.literals()[literals[2].literalIndex].isFloat);
+
+            EXPECT_EQ(lexer.literals()[literals[3].literalIndex].text, "a\tb");
+            EXPECT_EQ(lexer.literals()[literals[4].literalIndex].integer, 10u);
+        }
+
+        TEST(LexerTest, TestNumberPrefixesAndSuffixes) {
+            Lexer lexer("0b1010 0755 0xDEADbeef 42ULL 1.5L 0 1. 1.f 1.e5");
+
+            std::vector<std::string> expected = { "0b1010", "0755", "0xDEADbeef", "42ULL", "1.5L", "0", "1.", "1.f", "1.e5" };
+            for (const auto& lexeme : expected) {
+                Token token = lexer.getNextToken();
+                EXPECT_EQ(token.type, TokenType::Literal) << "Failed on literal: " << lexeme;
+                EXPECT_EQ(token.lexeme, lexeme);
+                EXPECT_TRUE(lexer.literals()[token.literalIndex].valid) << "Failed on literal: " << lexeme;
+            }
+
+            Token eofToken = lexer.getNextToken();
+            EXPECT_EQ(eofToken.type, TokenType::EndOfFile);
+        }
+
+        TEST(LexerTest, TestPeekToken) {
+            Lexer lexer("a + b;");
+
+            EXPECT_EQ(lexer.peekToken(0).lexeme, "a");
+            EXPECT_EQ(lexer.peekToken(2).lexeme, "b");
+            EXPECT_EQ(lexer.peekToken(4).type, TokenType::EndOfFile);
+
+            // Peeking doesn't consume
+            EXPECT_EQ(lexer.getNextToken().lexeme, "a");
+            EXPECT_EQ(lexer.peekToken(0).lexeme, "+");
+            EXPECT_EQ(lexer.getNextToken().lexeme, "+");
+            EXPECT_EQ(lexer.getNextToken().lexeme, "b");
+
+            EXPECT_THROW(lexer.peekToken(Lexer::LookaheadCapacity), std::out_of_range);
+        }
+
+        TEST(LexerTest, TestCheckpointRestoreWithinLookahead) {
+            Lexer lexer("int x = 42; float y;");
+            lexer.getNextToken(); // int
+
+            Checkpoint checkpoint = lexer.save();
+            EXPECT_EQ(lexer.getNextToken().lexeme, "x");
+            EXPECT_EQ(lexer.getNextToken().lexeme, "=");
+            Token literal = lexer.getNextToken();
+            EXPECT_EQ(literal.lexeme, "42");
+            size_t literalCount = lexer.literals().size();
+
+            // Tentative parse failed: rewind and read the same tokens again
+            lexer.restore(checkpoint);
+            Token again = lexer.getNextToken();
+            EXPECT_EQ(again.lexeme, "x");
+            EXPECT_EQ(again.column, 5);
+            lexer.getNextToken();
+            EXPECT_EQ(lexer.getNextToken().literalIndex, literal.literalIndex);
+            EXPECT_EQ(lexer.literals().size(), literalCount); // Served from the buffer, not re-lexed
+
+            EXPECT_EQ(lexer.getNextToken().lexeme, ";");
+            EXPECT_EQ(lexer.getNextToken().lexeme, "float");
+        }
+
+        TEST(LexerTest, TestCheckpointSavedWhilePeeking) {
+            Lexer lexer("a b c d");
+            lexer.peekToken(3);
+
+            // The checkpoint is the logical position, not how far the lexer has read ahead.
+            Checkpoint checkpoint = lexer.save();
+            EXPECT_EQ(checkpoint.tokenIndex, 0);
+            EXPECT_EQ(checkpoint.column, 1);
+
+            lexer.getNextToken();
+            lexer.getNextToken();
+            lexer.restore(checkpoint);
+            EXPECT_EQ(lexer.getNextToken().lexeme, "a");
+        }
+
+        TEST(LexerTest, TestCheckpointRestoreBeyondLookahead) {
+            std::string source = "first\n";
+            for (size_t i = 0; i < Lexer::LookaheadCapacity * 3; ++i) {
+                source += "t" + std::to_string(i) + " = " + std::to_string(i) + ";\n";
+            }
+            Lexer lexer(source);
+            lexer.getNextToken(); // first
+
+            Checkpoint checkpoint = lexer.save();
+            std::vector<Token> expected;
+            Token token;
+            while ((token = lexer.getNextToken()).type != TokenType::EndOfFile) {
+                expected.push_back(token);
+            }
+
+            // Far behind the ring buffer: the scanner itself is rewound
+            lexer.restore(checkpoint);
+            for (const Token& want : expected) {
+                Token got = lexer.getNextToken();
+                EXPECT_EQ(got.lexeme, want.lexeme);
+                EXPECT_EQ(got.line, want.line);
+                EXPECT_EQ(got.column, want.column);
+                EXPECT_EQ(got.literalIndex, want.literalIndex);
+            }
+            EXPECT_EQ(lexer.getNextToken().type, TokenType::EndOfFile);
+            EXPECT_EQ(lexer.literals().size(), Lexer::LookaheadCapacity * 3);
+        }
+
+        TEST(LexerTest, TestCheckpointRestoreAheadOfScanner) {
+            std::string source;
+            for (size_t i = 0; i < 60; ++i) {
+                source += std::to_string(i) + " ";
+            }
+            Lexer lexer(source);
+
+            Checkpoint start = lexer.save();
+            for (size_t i = 0; i < 25; ++i) {
+                lexer.getNextToken();
+            }
+            Checkpoint ahead = lexer.save();
+            Token expected = lexer.getNextToken(); // "25"
+
+            // Rewind past the ring buffer, then jump forward again to a checkpoint
+            // the scanner has not reached since.
+            lexer.restore(start);
+            lexer.restore(ahead);
+
+            Token token = lexer.getNextToken();
+            EXPECT_EQ(token.lexeme, "25");
+            EXPECT_EQ(token.column, expected.column);
+            EXPECT_EQ(token.literalIndex, expected.literalIndex);
+            EXPECT_EQ(token.literalIndex, 25);
+            ASSERT_LT(token.literalIndex, lexer.literals().size());
+            EXPECT_EQ(lexer.literals()[token.literalIndex].integer, 25u);
+        }
+
+        TEST(LexerTest, TestCheckpointAfterUnbufferedTokens) {
+            std::string source;
+            for (size_t i = 0; i < 40; ++i) {
+                source += "a" + std::to_string(i) + " ";
+            }
+            Lexer lexer(source);
+
+            // No checkpoint yet, so these bypass the lookahead ring.
+            for (size_t i = 0; i < 20; ++i) {
+                EXPECT_EQ(lexer.getNextToken().lexeme, "a" + std::to_string(i));
+            }
+
+            Checkpoint checkpoint = lexer.save();
+            EXPECT_EQ(lexer.getNextToken().lexeme, "a20");
+            EXPECT_EQ(lexer.getNextToken().lexeme, "a21");
+            lexer.restore(checkpoint);
+            EXPECT_EQ(lexer.getNextToken().lexeme, "a20");
+
+            // Once the checkpoint is out of ring range, restoring it rewinds the scanner.
+            for (size_t i = 21; i < 39; ++i) {
+                EXPECT_EQ(lexer.getNextToken().lexeme, "a" + std::to_string(i));
+            }
+            lexer.restore(checkpoint);
+            Token token = lexer.getNextToken();
+            EXPECT_EQ(token.lexeme, "a20");
+            EXPECT_EQ(token.column, 71);
+        }
+
+        TEST(LexerTest, TestRewindDoesNotRepeatDiagnostics) {
+            std::string source = "a @ b 7 \"s\"";
+            for (size_t i = 0; i < Lexer::LookaheadCapacity * 2; ++i) {
+                source += " c";
+            }
+            std::ostringstream diagnostics;
+            Lexer lexer(source);
+            lexer.setDiagnostics(diagnostics);
+
+            Checkpoint checkpoint = lexer.save();
+            std::vector<Token> abandoned;
+            for (size_t i = 0; i < Lexer::LookaheadCapacity * 2; ++i) {
+                abandoned.push_back(lexer.getNextToken());
+            }
+            std::string firstPass = diagnostics.str();
+            EXPECT_NE(firstPass.find("Line 1, Column 3: Unrecognized character"), std::string::npos);
+
+            // Past the ring buffer, so the scanner rescans the same stretch.
+            lexer.restore(checkpoint);
+            for (size_t i = 0; i < Lexer::LookaheadCapacity * 2; ++i) {
+                Token token = lexer.getNextToken();
+                EXPECT_EQ(token.lexeme, abandoned[i].lexeme);
+                EXPECT_EQ(token.literalIndex, abandoned[i].literalIndex);
+            }
+            EXPECT_EQ(diagnostics.str(), firstPass);
+
+            // Tokens kept from before the rewind still index valid entries.
+            EXPECT_EQ(lexer.literals().size(), 2);
+            EXPECT_EQ(lexer.literals()[abandoned[3].literalIndex].integer, 7u);
+            EXPECT_EQ(lexer.literals()[abandoned[4].literalIndex].text, "s");
+        }
 	}
 }
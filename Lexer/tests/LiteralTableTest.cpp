@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include "LiteralTable.h"
+#include <string>
+
+namespace CPPCompiler {
+	namespace Lexer {
+
+        TEST(LiteralTableTest, TestIntegerBases) {
+            LiteralTable table;
+
+            const LiteralValue& decimal = table[table.addNumber("42")];
+            EXPECT_EQ(decimal.kind, LiteralKind::Integer);
+            EXPECT_EQ(decimal.integer, 42u);
+            EXPECT_TRUE(decimal.valid);
+
+            EXPECT_EQ(table[table.addNumber("0x1F")].integer, 31u);
+            EXPECT_EQ(table[table.addNumber("0XfF")].integer, 255u);
+            EXPECT_EQ(table[table.addNumber("0b1010")].integer, 10u);
+            EXPECT_EQ(table[table.addNumber("0755")].integer, 493u);
+            EXPECT_EQ(table[table.addNumber("0")].integer, 0u);
+            EXPECT_EQ(table[table.addNumber("1'000'000")].integer, 1000000u);
+            EXPECT_EQ(table[table.addNumber("0xFF'FF")].integer, 65535u);
+            EXPECT_EQ(table[table.addNumber("18446744073709551615")].integer, 18446744073709551615ull);
+        }
+
+        TEST(LiteralTableTest, TestIntegerSuffixes) {
+            LiteralTable table;
+
+            const LiteralValue& unsignedLong = table[table.addNumber("42ul")];
+            EXPECT_TRUE(unsignedLong.valid);
+            EXPECT_TRUE(unsignedLong.isUnsigned);
+            EXPECT_EQ(unsignedLong.longCount, 1);
+
+            const LiteralValue& longLongUnsigned = table[table.addNumber("0x10LLU")];
+            EXPECT_TRUE(longLongUnsigned.valid);
+            EXPECT_TRUE(longLongUnsigned.isUnsigned);
+            EXPECT_EQ(longLongUnsigned.longCount, 2);
+            EXPECT_EQ(longLongUnsigned.integer, 16u);
+
+            EXPECT_FALSE(table[table.addNumber("1lL")].valid);
+            EXPECT_FALSE(table[table.addNumber("1uu")].valid);
+        }
+
+        TEST(LiteralTableTest, TestInvalidIntegers) {
+            LiteralTable table;
+            EXPECT_FALSE(table[table.addNumber("09")].valid);                   // Not octal
+            EXPECT_FALSE(table[table.addNumber("18446744073709551616")].valid); // Overflow
+        }
+
+        TEST(LiteralTableTest, TestFloatingLiterals) {
+            LiteralTable table;
+
+            const LiteralValue& pi = table[table.addNumber("3.14")];
+            EXPECT_EQ(pi.kind, LiteralKind::Floating);
+            EXPECT_DOUBLE_EQ(pi.floating, 3.14);
+
+            EXPECT_DOUBLE_EQ(table[table.addNumber("6.022e23")].floating, 6.022e23);
+            EXPECT_DOUBLE_EQ(table[table.addNumber(".5")].floating, 0.5);
+            EXPECT_DOUBLE_EQ(table[table.addNumber("1e-3")].floating, 1e-3);
+            EXPECT_DOUBLE_EQ(table[table.addNumber("1'000.000'5")].floating, 1000.0005);
+            EXPECT_DOUBLE_EQ(table[table.addNumber("1.")].floating, 1.0);
+            EXPECT_DOUBLE_EQ(table[table.addNumber("1.e5")].floating, 1e5);
+            EXPECT_TRUE(table[table.addNumber("1.f")].isFloat);
+
+            const LiteralValue& single = table[table.addNumber("2.5f")];
+            EXPECT_TRUE(single.isFloat);
+            EXPECT_DOUBLE_EQ(single.floating, 2.5);
+
+            const LiteralValue& extended = table[table.addNumber("2.5L")];
+            EXPECT_EQ(extended.longCount, 1);
+        }
+
+        TEST(LiteralTableTest, TestStringEscapes) {
+            LiteralTable table;
+
+            LiteralValue plain = table[table.addQuoted("\"Hello, World!\"")]; // Copy: later adds may grow the table
+            EXPECT_EQ(plain.kind, LiteralKind::String);
+            EXPECT_EQ(plain.text, "Hello, World!");
+
+            const LiteralValue& escaped = table[table.addQuoted(R"("a\tb\n\\\"\x41\101\0")")];
+            EXPECT_TRUE(escaped.valid);
+            EXPECT_EQ(escaped.text, std::string_view("a\tb\n\\\"AA\0", 9));
+
+            const LiteralValue& universal = table[table.addQuoted(R"("\u00E9\U0001F600")")];
+            EXPECT_TRUE(universal.valid);
+            EXPECT_EQ(universal.text, "\xC3\xA9\xF0\x9F\x98\x80");
+
+            EXPECT_FALSE(table[table.addQuoted(R"("\q")")].valid);
+            EXPECT_FALSE(table[table.addQuoted(R"("\x100")")].valid);
+            EXPECT_FALSE(table[table.addQuoted(R"("\uD800")")].valid);
+
+            // Earlier views stay valid while the arena grows.
+            std::string large(40000, 'z');
+            table.addQuoted("\"" + large + "\"");
+            EXPECT_EQ(plain.text, "Hello, World!");
+        }
+
+        TEST(LiteralTableTest, TestCharacterLiterals) {
+            LiteralTable table;
+
+            const LiteralValue& letter = table[table.addQuoted("'a'")];
+            EXPECT_EQ(letter.kind, LiteralKind::Character);
+            EXPECT_EQ(letter.integer, 97u);
+
+            EXPECT_EQ(table[table.addQuoted(R"('\n')")].integer, 10u);
+            EXPECT_EQ(table[table.addQuoted(R"('\xff')")].integer, 255u);
+            EXPECT_EQ(table[table.addQuoted("'ab'")].integer, 0x6162u);
+            EXPECT_FALSE(table[table.addQuoted("''")].valid);
+        }
+
+        TEST(LiteralTableTest, TestClearReusesArena) {
+            LiteralTable table;
+            std::string large = "\"" + std::string(20 * 1024, 'x') + "\""; // Bigger than one arena chunk
+
+            const char* firstText = table[table.addQuoted("\"abc\"")].text.data();
+            const char* largeText = table[table.addQuoted(large)].text.data();
+            EXPECT_EQ(table.size(), 2);
+
+            table.clear();
+            EXPECT_EQ(table.size(), 0);
+
+            // Refilled in the same order, the strings land in the kept chunks.
+            size_t index = table.addQuoted("\"def\"");
+            EXPECT_EQ(index, 0);
+            EXPECT_EQ(table[index].text, "def");
+            EXPECT_EQ(table[index].text.data(), firstText);
+            EXPECT_EQ(table[table.addQuoted(large)].text.data(), largeText);
+        }
+	}
+}
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "PipelinedLexer.h"
+#include <vector>
+
+namespace CPPCompiler {
+	namespace Lexer {
+
+        TEST(PipelinedLexerTest, TestMatchesPullLexer) {
+            std::string source = "int main() { int x = 42; return x + 3.14; } // done";
+
+            std::vector<Token> expected;
+            Lexer lexer(source);
+            Token token;
+            do {
+                token = lexer.getNextToken();
+                expected.push_back(token);
+            } while (token.type != TokenType::EndOfFile);
+
+            std::vector<TokenView> actual;
+            PipelinedLexer pipeline(source);
+            pipeline.forEachToken([&](const TokenView& t) { actual.push_back(t); });
+
+            ASSERT_EQ(actual.size(), expected.size());
+            for (size_t i = 0; i < actual.size(); ++i) {
+                EXPECT_EQ(actual[i].type, expected[i].type) << "Token mismatch at position " << i;
+                EXPECT_EQ(actual[i].lexeme, expected[i].lexeme) << "Token mismatch at position " << i;
+                EXPECT_EQ(actual[i].line, expected[i].line) << "Token mismatch at position " << i;
+                EXPECT_EQ(actual[i].column, expected[i].column) << "Token mismatch at position " << i;
+            }
+        }
+
+        TEST(PipelinedLexerTest, TestBatchingAndRecycling) {
+            // Enough tokens to cycle through every batch more than once.
+            const size_t identifierCount = PipelinedLexer::BatchSize * PipelinedLexer::BatchCount * 3 + 7;
+            std::string source;
+            for (size_t i = 0; i < identifierCount; ++i) {
+                source += "x ";
+            }
+
+            PipelinedLexer pipeline(source);
+            size_t tokenCount = 0;
+            size_t batchCount = 0;
+            bool sawLast = false;
+            while (const TokenBatch* batch = pipeline.acquireBatch()) {
+                EXPECT_FALSE(sawLast);
+                EXPECT_LE(batch->tokens.size(), PipelinedLexer::BatchSize);
+                tokenCount += batch->tokens.size();
+                sawLast = batch->isLast;
+                ++batchCount;
+                pipeline.releaseBatch(batch);
+            }
+
+            EXPECT_TRUE(sawLast);
+            EXPECT_EQ(tokenCount, identifierCount + 1); // Plus EndOfFile
+            EXPECT_EQ(batchCount, identifierCount / PipelinedLexer::BatchSize + 1);
+        }
+
+        TEST(PipelinedLexerTest, TestEmptySource) {
+            PipelinedLexer pipeline("");
+
+            const TokenBatch* batch = pipeline.acquireBatch();
+            ASSERT_NE(batch, nullptr);
+            ASSERT_EQ(batch->tokens.size(), 1);
+            EXPECT_EQ(batch->tokens[0].type, TokenType::EndOfFile);
+            EXPECT_TRUE(batch->isLast);
+            pipeline.releaseBatch(batch);
+
+            EXPECT_EQ(pipeline.acquireBatch(), nullptr);
+        }
+
+        TEST(PipelinedLexerTest, TestEarlyDestruction) {
+            std::string source;
+            for (size_t i = 0; i < PipelinedLexer::BatchSize * PipelinedLexer::BatchCount * 4; ++i) {
+                source += "y ";
+            }
+
+            // Consumer stops after one batch; destructor must unblock the lexer thread.
+            PipelinedLexer pipeline(source);
+            const TokenBatch* batch = pipeline.acquireBatch();
+            ASSERT_NE(batch, nullptr);
+            EXPECT_EQ(batch->tokens.size(), PipelinedLexer::BatchSize);
+        }
+
+        TEST(PipelinedLexerTest, TestLiteralValuesInBatch) {
+            // Spans several batches so later values are read while the lexer is still appending.
+            const size_t literalCount = PipelinedLexer::BatchSize * 3;
+            std::string source;
+            for (size_t i = 0; i < literalCount; ++i) {
+                source += std::to_string(i) + " \"s" + std::to_string(i) + "\" ";
+            }
+
+            PipelinedLexer pipeline(source);
+            size_t numbers = 0;
+            size_t strings = 0;
+            while (const TokenBatch* batch = pipeline.acquireBatch()) {
+                for (const TokenView& token : batch->tokens) {
+                    if (token.type != TokenType::Literal) {
+                        continue;
+                    }
+                    EXPECT_LT(token.literalIndex, batch->literals.size()); // Numbered per batch
+                    const LiteralValue& value = batch->literal(token);
+                    if (value.kind == LiteralKind::Integer) {
+                        EXPECT_EQ(value.integer, numbers);
+                        ++numbers;
+                    }
+                    else {
+                        EXPECT_EQ(value.text, "s" + std::to_string(strings));
+                        ++strings;
+                    }
+                }
+                pipeline.releaseBatch(batch);
+            }
+
+            EXPECT_EQ(numbers, literalCount);
+            EXPECT_EQ(strings, literalCount);
+        }
+	}
+}
@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+#include "Utf8.h"
+#include <string>
+
+namespace CPPCompiler {
+	namespace Lexer {
+
+        TEST(Utf8Test, TestIsAscii) {
+            EXPECT_TRUE(Utf8::isAscii(""));
+            EXPECT_TRUE(Utf8::isAscii("int main() { return 0; }"));
+
+            // Place a non-ASCII byte at every offset to cover the wide and scalar paths.
+            for (size_t position = 0; position < 40; ++position) {
+                std::string text(40, 'a');
+                text[position] = '\x80';
+                EXPECT_FALSE(Utf8::isAscii(text)) << "Missed non-ASCII byte at offset " << position;
+            }
+        }
+
+        TEST(Utf8Test, TestDecode) {
+            char32_t codePoint = 0;
+
+            EXPECT_EQ(Utf8::decode("\xC3\xA9", 0, codePoint), 2);
+            EXPECT_EQ(codePoint, U'\u00E9');
+
+            EXPECT_EQ(Utf8::decode("\xE2\x82\xAC", 0, codePoint), 3);
+            EXPECT_EQ(codePoint, U'\u20AC');
+
+            EXPECT_EQ(Utf8::decode("\xF0\x9F\x98\x80", 0, codePoint), 4);
+            EXPECT_EQ(codePoint, U'\U0001F600');
+
+            EXPECT_EQ(Utf8::decode("\xC0\xAF", 0, codePoint), 0);     // Overlong '/'
+            EXPECT_EQ(Utf8::decode("\xED\xA0\x80", 0, codePoint), 0); // Surrogate
+            EXPECT_EQ(Utf8::decode("\xE2\x82", 0, codePoint), 0);     // Truncated
+            EXPECT_EQ(Utf8::decode("\x80", 0, codePoint), 0);         // Stray continuation byte
+        }
+
+        TEST(Utf8Test, TestIdentifierProperties) {
+            EXPECT_TRUE(Utf8::isXidStart(U'\u00E9'));  // Latin small e with acute
+            EXPECT_TRUE(Utf8::isXidStart(U'\u0394'));  // Greek capital delta
+            EXPECT_TRUE(Utf8::isXidStart(U'\u4E2D'));  // CJK ideograph
+            EXPECT_FALSE(Utf8::isXidStart(U'\u20AC')); // Euro sign
+            EXPECT_FALSE(Utf8::isXidStart(U'\u0301')); // Combining acute accent
+
+            EXPECT_TRUE(Utf8::isXidContinue(U'\u0301'));
+            EXPECT_TRUE(Utf8::isXidContinue(U'\u0663')); // Arabic-Indic digit three
+            EXPECT_FALSE(Utf8::isXidContinue(U'\u00A0')); // No-break space
+        }
+	}
+}